@@ -0,0 +1,189 @@
+//
+// InternIndex puts a hash index in front of one of the string tables
+// of stringtab.h (idtable, stringtable or inttable).
+//
+// StringTable::add_string and lookup_string walk the whole list of
+// entries to find a match, so interning N distinct strings is O(N^2).
+// InternIndex keeps an open-addressing table of the entries, with each
+// one's hash and length, and compares against the entry's own text. It
+// hands out the very same Entry objects: a string interned through the
+// index and through the table directly yields the same Symbol.
+//
+// New entries are linked into the table exactly as add_string would
+// link them, with the same numbering. Entries added to the table
+// behind the index's back (add_int, or add_string from other code) are
+// picked up from the head of the list on the next call.
+//
+
+#ifndef _INTERNTAB_H_
+#define _INTERNTAB_H_
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "stringtab.h"
+
+template <class Elem>
+class InternIndex
+{
+private:
+   struct Slot {
+      uint32_t hash;
+      uint32_t len;
+      Elem *elem;          // NULL if the slot is empty
+   };
+
+   // StringTable keeps its list and counter protected. A derived class
+   // may name them, which gives member pointers usable on any table.
+   struct Access : StringTable<Elem> {
+      static List<Elem> *StringTable<Elem>::*list() { return &Access::tbl; }
+      static int StringTable<Elem>::*counter() { return &Access::index; }
+   };
+
+   StringTable<Elem> &table;
+   std::vector<Slot> slots;       // size is a power of two
+   size_t count;
+   List<Elem> *synced;            // list head when the index was last in step
+
+   static uint32_t hash(const char *s, int len)
+   {
+      uint32_t h = 2166136261u;
+      for (int i = 0; i < len; i++) {
+         h ^= (unsigned char) s[i];
+         h *= 16777619u;
+      }
+      return h;
+   }
+
+   Slot *find(const char *s, int len, uint32_t h)
+   {
+      size_t mask = slots.size() - 1;
+      for (size_t i = h & mask; ; i = (i + 1) & mask) {
+         Slot &slot = slots[i];
+         if (slot.elem == NULL)
+            return &slot;
+         if (slot.hash == h && slot.len == (uint32_t) len
+               && memcmp(slot.elem->get_string(), s, len) == 0)
+            return &slot;
+      }
+   }
+
+   void grow()
+   {
+      std::vector<Slot> old(slots.size() * 2);
+      old.swap(slots);
+      for (size_t i = 0; i < slots.size(); i++)
+         slots[i].elem = NULL;
+
+      size_t mask = slots.size() - 1;
+      for (size_t i = 0; i < old.size(); i++) {
+         if (old[i].elem == NULL)
+            continue;
+         size_t j = old[i].hash & mask;
+         while (slots[j].elem != NULL)
+            j = (j + 1) & mask;
+         slots[j] = old[i];
+      }
+   }
+
+   void insert(Slot *slot, Elem *e, uint32_t h)
+   {
+      slot->hash = h;
+      slot->len = e->get_len();
+      slot->elem = e;
+
+      if (++count * 2 > slots.size())
+         grow();
+   }
+
+   // Index the entries added to the table since the last call. The
+   // list grows at its head, so they are the ones in front of synced.
+   // add_string never links in a string that is already there, so none
+   // of them can be in the index yet.
+   void sync()
+   {
+      List<Elem> *head = table.*Access::list();
+
+      for (List<Elem> *l = head; l != synced; l = l->tl()) {
+         Elem *e = l->hd();
+         uint32_t h = hash(e->get_string(), e->get_len());
+         Slot *slot = find(e->get_string(), e->get_len(), h);
+         if (slot->elem == NULL)
+            insert(slot, e, h);
+      }
+
+      synced = head;
+   }
+
+public:
+   InternIndex(StringTable<Elem>& t) : table(t), slots(1024), count(0), synced(NULL)
+   {
+      for (size_t i = 0; i < slots.size(); i++)
+         slots[i].elem = NULL;
+   }
+
+   // Same as StringTable::add_string(s, maxchars).
+   Elem *add_string(char *s, int maxchars)
+   {
+      int len = strlen(s);
+      if (len > maxchars)
+         len = maxchars;
+
+      sync();
+
+      uint32_t h = hash(s, len);
+      Slot *slot = find(s, len, h);
+      if (slot->elem != NULL)
+         return slot->elem;
+
+      List<Elem> *&head = table.*Access::list();
+      Elem *e = new Elem(s, len, (table.*Access::counter())++);
+      head = new List<Elem>(e, head);
+      synced = head;
+
+      insert(slot, e, h);
+      return e;
+   }
+
+   Elem *add_string(char *s)
+   {
+      return add_string(s, strlen(s));
+   }
+
+   // Frees every entry of the table and empties it, for a table nothing
+   // else points into any more. An entry's text is its own copy, made
+   // with new char[] by the Entry constructor.
+   void free_table()
+   {
+      List<Elem> *&head = table.*Access::list();
+
+      for (List<Elem> *l = head; l != NULL; ) {
+         List<Elem> *next = l->tl();
+         delete [] l->hd()->get_string();
+         delete l->hd();
+         delete l;
+         l = next;
+      }
+
+      head = NULL;
+      synced = NULL;
+      count = 0;
+      for (size_t i = 0; i < slots.size(); i++)
+         slots[i].elem = NULL;
+   }
+
+   // Same as StringTable::lookup_string; the string must be there.
+   Elem *lookup_string(char *s)
+   {
+      int len = strlen(s);
+
+      sync();
+
+      Slot *slot = find(s, len, hash(s, len));
+      assert(slot->elem != NULL);
+      return slot->elem;
+   }
+};
+
+#endif
@@ -0,0 +1,121 @@
+//
+// Reentrant interface to the COOL scanner in cool.flex.
+//
+// A CoolLexer holds everything one scan needs: its input, the current
+// line, the value of the last token and the state for assembling
+// string constants and matching nested comments. Separate CoolLexers
+// can run on separate threads; interning into the global string
+// tables is serialized inside the scanner.
+//
+// cool_yylex() is still there for the rest of the compiler. It runs
+// one CoolLexer on fin and reports through cool_yylval and curr_lineno.
+//
+// A TokenCache keeps the tokens of one text along with the scanner's
+// state at the start of every line, so that after an edit only the
+// lines from the edit up to where the scan falls back in step with the
+// old tokens are lexed again.
+//
+
+#ifndef _SCANNER_H_
+#define _SCANNER_H_
+
+#include <stdio.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cool-parse.h>
+#include "interntab.h"
+#include "tokenbuf.h"
+
+/* Max size of string constants */
+#define MAX_STR_CONST 1025
+
+// The state of the scanner at the start of a line.
+struct LineStart {
+  size_t offset;                    /* of the line in the text */
+  int condition;                    /* flex start condition: INITIAL, comment or string */
+  int comment_depth;
+};
+
+struct CoolLexer {
+  FILE *in;
+  int lineno;
+  YYSTYPE yylval;
+
+  char string_buf[MAX_STR_CONST];   /* to assemble string constants */
+  int string_length;
+  int extra_length;
+  int comment_depth;
+  int is_broken_string;
+
+  int input_started;                /* see start_input in cool.flex */
+  char *mapped_base;
+  size_t mapped_len;
+  void *mapped_buffer;
+
+  void *scanner;                    /* the flex scanner */
+
+  size_t offset;                    /* of the next character in the input */
+  std::vector<LineStart> *lines;    /* if not NULL, each new line is added */
+
+  /* Where symbols are interned; the global tables if NULL. */
+  InternIndex<StringEntry> *strings;
+  InternIndex<IntEntry> *ints;
+};
+
+// The tokens of one input file. opened is false if it couldn't be read.
+struct LexedFile {
+  const char *name;
+  bool opened;
+  std::vector<CoolToken> tokens;
+};
+
+// A text and its tokens. ends[i] is the offset just past tokens[i], and
+// lines[i] the state at the start of line i + 1.
+struct TokenCache {
+  std::string text;
+  std::vector<CoolToken> tokens;
+  std::vector<size_t> ends;
+  std::vector<LineStart> lines;
+};
+
+// Sets up lex to read from in, starting at line 1.
+bool cool_lex_init(CoolLexer *lex, FILE *in);
+
+// Returns the next token, or 0 at the end of the input. The token's
+// value is left in lex->yylval and its line in lex->lineno.
+int cool_lex_next(CoolLexer *lex);
+
+void cool_lex_destroy(CoolLexer *lex);
+
+// Appends all the remaining tokens of lex to tokens.
+void cool_lex_all(CoolLexer *lex, std::vector<CoolToken>& tokens);
+
+// Lexes the named files on a pool of threads, one file at a time per
+// thread. Each thread interns into tables of its own; their symbols are
+// added to the global tables afterwards in file and token order, so
+// every Symbol, and its index, is what lexing the files one after the
+// other would have produced.
+void cool_lex_files(int n, char **names, std::vector<LexedFile>& files);
+
+// Writes tokens to out as one chunk of the binary token stream (see
+// tokstream.h).
+void cool_lex_write_chunk(const std::vector<CoolToken>& tokens, std::ostream& out);
+
+// Lexes all of in and writes its tokens to out as one chunk. False if
+// the scanner can't be set up.
+bool cool_lex_write_binary(FILE *in, std::ostream& out);
+
+// Lexes len bytes of text into cache.
+void cool_lex_cache(TokenCache& cache, const char *text, size_t len);
+
+// Replaces removed bytes of cache.text at start by len bytes of text
+// and brings the tokens up to date. Lexing restarts at the last line
+// at or before start that doesn't begin inside a string constant, and
+// stops at the first line after the new text that begins in the same
+// state as before the edit; the old tokens from there on are kept,
+// with their lines and offsets moved. Returns false, and leaves cache
+// alone, if the removed bytes aren't all in cache.text.
+bool cool_lex_edit(TokenCache& cache, size_t start, size_t removed, const char *text, size_t len);
+
+#endif
@@ -0,0 +1,35 @@
+//
+// Tokens in bulk, for handing a whole file from the lexer to the parser
+// at once instead of one cool_yylex call per token.
+//
+// Include this once YYSTYPE is defined: after cool-parse.h, or after
+// the %union in cool.y.
+//
+
+#ifndef _TOKENBUF_H_
+#define _TOKENBUF_H_
+
+#include <stddef.h>
+
+// A token as cool_yylex would have returned it. It is 16 bytes, so the
+// tokens of a file sit densely in one array.
+struct CoolToken {
+  int kind;
+  int lineno;
+  YYSTYPE value;
+};
+
+// A read cursor over an array of tokens.
+struct TokenBuffer {
+  const CoolToken *next;
+  const CoolToken *end;
+
+  TokenBuffer() : next(NULL), end(NULL) { }
+  TokenBuffer(const CoolToken *b, const CoolToken *e) : next(b), end(e) { }
+};
+
+// When set, the parser takes its tokens from here instead of calling
+// cool_yylex (see cool.y).
+extern TokenBuffer *cool_token_buffer;
+
+#endif
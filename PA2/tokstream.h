@@ -0,0 +1,76 @@
+//
+// Binary token stream between the lexer and the parser.
+//
+// lexstream (PA2) writes the tokens of each file as one binary chunk,
+// right after a "#name" line like the one lextest prints for it. With
+// COOL_LEX_BINARY set in its environment, the parser loads the whole
+// stream into a token array instead of reading tokens as text.
+//
+//   chunk  := magic version nstrings string* ntokens token*
+//   string := length byte*
+//   token  := kind line-delta [value]
+//
+// Numbers are unsigned LEB128 varints. Line deltas are from the
+// previous token of the chunk, the first from line 1. Strings are
+// numbered in order of first use within the chunk. The value of a
+// TYPEID, OBJECTID, STR_CONST or INT_CONST is a string number, that of
+// a BOOL_CONST is 0 or 1, and an ERROR carries its message as a length
+// and bytes. Other tokens have no value.
+//
+
+#ifndef _TOKSTREAM_H_
+#define _TOKSTREAM_H_
+
+#include <stdint.h>
+#include <string>
+
+static const char TOKSTREAM_MAGIC[8] = { '\x7f', 'C', 'O', 'O', 'L', 'T', 'O', 'K' };
+static const uint64_t TOKSTREAM_VERSION = 1;
+
+// Kind of the pseudo-token the parser's loader puts in front of each
+// file's tokens; its value.error_msg is the file name.
+static const int FILE_NAME_TOKEN = -1;
+
+inline void put_varint(std::string& out, uint64_t v)
+{
+  while (v >= 0x80) {
+    out.push_back((char) (v | 0x80));
+    v >>= 7;
+  }
+  out.push_back((char) v);
+}
+
+inline void put_bytes(std::string& out, const char *s, size_t len)
+{
+  put_varint(out, len);
+  out.append(s, len);
+}
+
+// Reads a varint at p, advancing p; false if it runs past end.
+inline bool get_varint(const char *&p, const char *end, uint64_t *v)
+{
+  uint64_t r = 0;
+
+  for (int shift = 0; shift < 64 && p < end; shift += 7) {
+    unsigned char c = *p++;
+    r |= (uint64_t) (c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      *v = r;
+      return true;
+    }
+  }
+  return false;
+}
+
+inline bool get_bytes(const char *&p, const char *end, std::string *s)
+{
+  uint64_t len;
+
+  if (!get_varint(p, end, &len) || len > (uint64_t) (end - p))
+    return false;
+  s->assign(p, len);
+  p += len;
+  return true;
+}
+
+#endif
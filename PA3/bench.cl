@@ -0,0 +1,174 @@
+(*
+ *  Seed corpus for frontbench. It is repeated to make the larger
+ *  corpora, so keep it fixed: changing it changes every measurement.
+ *  It only has to lex and parse cleanly, not type check.
+ *)
+
+class List {
+   -- An empty list; Cons overrides the interesting methods.
+   isNil() : Bool { true };
+
+   head() : Int { { abort(); 0; } };
+
+   tail() : List { { abort(); self; } };
+
+   cons(i : Int) : List {
+      (new Cons).init(i, self)
+   };
+
+   length() : Int { 0 };
+};
+
+class Cons inherits List {
+   car : Int;
+   cdr : List;
+
+   isNil() : Bool { false };
+
+   head() : Int { car };
+
+   tail() : List { cdr };
+
+   init(i : Int, rest : List) : List {
+      {
+         car <- i;
+         cdr <- rest;
+         self;
+      }
+   };
+
+   length() : Int { 1 + cdr.length() };
+};
+
+class Counter inherits IO {
+   count : Int <- 0;
+   limit : Int <- 1000;
+   name : String <- "counter\t(* not a comment *)\n";
+
+   step(by : Int) : SELF_TYPE {
+      {
+         count <- count + by;
+         if limit < count then count <- 0 else count fi;
+         self;
+      }
+   };
+
+   run(n : Int) : Int {
+      let i : Int <- 0, total : Int in {
+         while i < n loop {
+            total <- total + i * 2 - i / 3;
+            i <- i + 1;
+         } pool;
+         total;
+      }
+   };
+
+   describe(x : Object) : String {
+      case x of
+         i : Int => "an \"Int\"";
+         s : String => s.concat(" is a String");
+         b : Bool => if b then "true" else "false" fi;
+         l : List => "a List of ".concat((new A2I).i2a(l.length()));
+         o : Object => "something else";
+      esac
+   };
+
+   report() : SELF_TYPE {
+      {
+         out_string(name);
+         out_int(count);
+         out_string("\n");
+      }
+   };
+};
+
+(* A2I converts between integers and strings.
+   (* Comments nest, *) and this one carries on
+   over several lines. *)
+class A2I {
+   c2i(char : String) : Int {
+      if char = "0" then 0 else
+      if char = "1" then 1 else
+      if char = "2" then 2 else
+      if char = "3" then 3 else
+      if char = "4" then 4 else
+      if char = "5" then 5 else
+      if char = "6" then 6 else
+      if char = "7" then 7 else
+      if char = "8" then 8 else
+      if char = "9" then 9 else
+      { abort(); 0; }
+      fi fi fi fi fi fi fi fi fi fi
+   };
+
+   i2c(i : Int) : String {
+      if i = 0 then "0" else
+      if i = 1 then "1" else
+      if i = 2 then "2" else
+      if i = 3 then "3" else
+      if i = 4 then "4" else
+      if i = 5 then "5" else
+      if i = 6 then "6" else
+      if i = 7 then "7" else
+      if i = 8 then "8" else
+      if i = 9 then "9" else
+      { abort(); ""; }
+      fi fi fi fi fi fi fi fi fi fi
+   };
+
+   a2i(s : String) : Int {
+      if s.length() = 0 then 0 else
+      if s.substr(0, 1) = "-" then ~a2i_aux(s.substr(1, s.length() - 1)) else
+      if s.substr(0, 1) = "+" then a2i_aux(s.substr(1, s.length() - 1)) else
+         a2i_aux(s)
+      fi fi fi
+   };
+
+   a2i_aux(s : String) : Int {
+      (let int : Int <- 0 in {
+         (let j : Int <- s.length() in
+            (let i : Int <- 0 in
+               while i < j loop {
+                  int <- int * 10 + c2i(s.substr(i, 1));
+                  i <- i + 1;
+               } pool
+            )
+         );
+         int;
+      })
+   };
+
+   i2a(i : Int) : String {
+      if i = 0 then "0" else
+      if 0 < i then i2a_aux(i) else
+         "-".concat(i2a_aux(i * ~1))
+      fi fi
+   };
+
+   i2a_aux(i : Int) : String {
+      if i = 0 then "" else
+         (let next : Int <- i / 10 in
+            i2a_aux(next).concat(i2c(i - next * 10))
+         )
+      fi
+   };
+};
+
+class Main inherits IO {
+   list : List <- new List;
+   counter : Counter <- new Counter;
+
+   main() : Object {
+      {
+         list <- list.cons(1).cons(2).cons(3);
+         counter@Counter.step(list.length()).report();
+         if not isvoid list then
+            out_string(counter.describe(list))
+         else
+            out_string("void\n")
+         fi;
+         counter.run(100) <= 4950;
+         self.out_int((new A2I).a2i("-1234"));
+      }
+   };
+};
@@ -1,21 +1,22 @@
-/* A Bison parser, made by GNU Bison 2.5.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
-   
-      Copyright (C) 1984, 1989-1990, 2000-2011 Free Software Foundation, Inc.
-   
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
    the Free Software Foundation, either version 3 of the License, or
    (at your option) any later version.
-   
+
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
    GNU General Public License for more details.
-   
+
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -26,46 +27,67 @@
    special exception, which will cause the skeleton and the resulting
    Bison output files to be licensed under the GNU General Public
    License without this special exception.
-   
+
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
 
-/* Tokens.  */
+#ifndef YY_COOL_YY_COOL_TAB_H_INCLUDED
+# define YY_COOL_YY_COOL_TAB_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 1
+#endif
+#if YYDEBUG
+extern int cool_yydebug;
+#endif
+
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     CLASS = 258,
-     ELSE = 259,
-     FI = 260,
-     IF = 261,
-     IN = 262,
-     INHERITS = 263,
-     LET = 264,
-     LOOP = 265,
-     POOL = 266,
-     THEN = 267,
-     WHILE = 268,
-     CASE = 269,
-     ESAC = 270,
-     OF = 271,
-     DARROW = 272,
-     NEW = 273,
-     ISVOID = 274,
-     STR_CONST = 275,
-     INT_CONST = 276,
-     BOOL_CONST = 277,
-     TYPEID = 278,
-     OBJECTID = 279,
-     ASSIGN = 280,
-     NOT = 281,
-     LE = 282,
-     ERROR = 283
-   };
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 284,                 /* "invalid token"  */
+    CLASS = 258,                   /* CLASS  */
+    ELSE = 259,                    /* ELSE  */
+    FI = 260,                      /* FI  */
+    IF = 261,                      /* IF  */
+    IN = 262,                      /* IN  */
+    INHERITS = 263,                /* INHERITS  */
+    LET = 264,                     /* LET  */
+    LOOP = 265,                    /* LOOP  */
+    POOL = 266,                    /* POOL  */
+    THEN = 267,                    /* THEN  */
+    WHILE = 268,                   /* WHILE  */
+    CASE = 269,                    /* CASE  */
+    ESAC = 270,                    /* ESAC  */
+    OF = 271,                      /* OF  */
+    DARROW = 272,                  /* DARROW  */
+    NEW = 273,                     /* NEW  */
+    ISVOID = 274,                  /* ISVOID  */
+    STR_CONST = 275,               /* STR_CONST  */
+    INT_CONST = 276,               /* INT_CONST  */
+    BOOL_CONST = 277,              /* BOOL_CONST  */
+    TYPEID = 278,                  /* TYPEID  */
+    OBJECTID = 279,                /* OBJECTID  */
+    ASSIGN = 280,                  /* ASSIGN  */
+    NOT = 281,                     /* NOT  */
+    LE = 282,                      /* LE  */
+    ERROR = 283                    /* ERROR  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
-/* Tokens.  */
+/* Token kinds.  */
+#define YYEMPTY -2
+#define YYEOF 0
+#define YYerror 256
+#define YYUNDEF 284
 #define CLASS 258
 #define ELSE 259
 #define FI 260
@@ -93,14 +115,10 @@
 #define LE 282
 #define ERROR 283
 
-
-
-
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
+union YYSTYPE
 {
-
-/* Line 2068 of yacc.c  */
 #line 89 "cool.y"
 
       Boolean boolean;
@@ -119,29 +137,33 @@ typedef union YYSTYPE
       char *error_msg;
     
 
+#line 141 "cool.tab.h"
 
-/* Line 2068 of yacc.c  */
-#line 125 "cool.tab.h"
-} YYSTYPE;
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
 # define YYSTYPE_IS_DECLARED 1
 #endif
 
-extern YYSTYPE cool_yylval;
-
+/* Location type.  */
 #if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE
+typedef struct YYLTYPE YYLTYPE;
+struct YYLTYPE
 {
   int first_line;
   int first_column;
   int last_line;
   int last_column;
-} YYLTYPE;
-# define yyltype YYLTYPE /* obsolescent; will be withdrawn */
+};
 # define YYLTYPE_IS_DECLARED 1
 # define YYLTYPE_IS_TRIVIAL 1
 #endif
 
+
+extern YYSTYPE cool_yylval;
 extern YYLTYPE cool_yylloc;
 
+int cool_yyparse (void);
+
+
+#endif /* !YY_COOL_YY_COOL_TAB_H_INCLUDED  */
@@ -125,6 +125,62 @@
     /*  DON'T CHANGE ANYTHING ABOVE THIS LINE, OR YOUR PARSER WONT WORK       */
     /**************************************************************************/
     
+    %{
+    #include <vector>
+    #include "../PA2/tokenbuf.h"
+    #include "../PA2/tokstream.h"
+    #include "../PA2/interntab.h"
+    
+    extern YYSTYPE cool_yylval;
+    extern int curr_lineno;
+    
+    /* If a driver has lexed the input in bulk, the parser reads the tokens
+    straight from the array, with no call into the lexer per token. */
+    TokenBuffer *cool_token_buffer = NULL;
+    
+    static TokenBuffer *read_token_stream(FILE *in);
+    
+    /* Hash indexes over the global tables, for the symbols of a binary
+    token stream: add_string on a table walks its whole list. */
+    static InternIndex<IdEntry> id_index(idtable);
+    static InternIndex<StringEntry> string_index(stringtable);
+    static InternIndex<IntEntry> int_index(inttable);
+    static bool token_stream_checked = false;
+    
+    static inline int next_token()
+    {
+      if (!token_stream_checked) {
+        token_stream_checked = true;
+        if (cool_token_buffer == NULL && getenv("COOL_LEX_BINARY") != NULL)
+          cool_token_buffer = read_token_stream(stdin);
+      }
+      
+      TokenBuffer *b = cool_token_buffer;
+      
+      if (b == NULL)
+        return cool_yylex();
+      
+      for (;;) {
+        if (b->next == b->end)
+          return 0;
+        
+        const CoolToken *t = b->next++;
+        
+        if (t->kind == FILE_NAME_TOKEN) {
+          curr_filename = t->value.error_msg;
+          continue;
+        }
+        
+        cool_yylval = t->value;
+        curr_lineno = t->lineno;
+        return t->kind;
+      }
+    }
+    
+    #undef yylex
+    #define yylex next_token
+    %}
+    
     /* Complete the nonterminal list below, giving a type for the semantic
     value of each non terminal. (See section 3.6 in the bison 
     documentation for details). */
@@ -318,3 +374,134 @@
     }
     
     
+    
+    /* Decodes one chunk of a binary token stream (see tokstream.h) at p.
+    Symbols are interned into the same tables the text front end uses. */
+    static bool read_token_chunk(const char *&p, const char *end, 
+    std::vector<CoolToken>& tokens)
+    {
+      uint64_t version, nstrings, ntokens;
+      
+      if ((size_t) (end - p) < sizeof(TOKSTREAM_MAGIC) 
+          || memcmp(p, TOKSTREAM_MAGIC, sizeof(TOKSTREAM_MAGIC)) != 0)
+        return false;
+      p += sizeof(TOKSTREAM_MAGIC);
+      
+      if (!get_varint(p, end, &version) || version != TOKSTREAM_VERSION
+          || !get_varint(p, end, &nstrings) || nstrings > (uint64_t) (end - p))
+        return false;
+      
+      std::vector<std::string> strings(nstrings);
+      for (uint64_t i = 0; i < nstrings; i++)
+        if (!get_bytes(p, end, &strings[i]))
+          return false;
+      
+      /* Each string interned at most once per table it is used with. */
+      std::vector<Symbol> ids(nstrings), strs(nstrings), ints(nstrings);
+      
+      if (!get_varint(p, end, &ntokens) || ntokens > (uint64_t) (end - p))
+        return false;
+      tokens.reserve(tokens.size() + ntokens);
+      
+      int line = 1;
+      for (uint64_t i = 0; i < ntokens; i++) {
+        uint64_t kind, delta, value;
+        CoolToken t;
+        
+        if (!get_varint(p, end, &kind) || !get_varint(p, end, &delta))
+          return false;
+        
+        t.kind = (int) kind;
+        line += (int) delta;
+        t.lineno = line;
+        t.value.symbol = NULL;
+        
+        switch (t.kind) {
+          case TYPEID:
+          case OBJECTID:
+          case STR_CONST:
+          case INT_CONST: {
+            if (!get_varint(p, end, &value) || value >= nstrings)
+              return false;
+            
+            char *text = (char *) strings[value].c_str();
+            Symbol *sym = (t.kind == STR_CONST) ? &strs[value] 
+              : (t.kind == INT_CONST) ? &ints[value] : &ids[value];
+            
+            if (*sym == NULL) {
+              if (t.kind == STR_CONST)
+                *sym = string_index.add_string(text);
+              else if (t.kind == INT_CONST)
+                *sym = int_index.add_string(text);
+              else
+                *sym = id_index.add_string(text);
+            }
+            t.value.symbol = *sym;
+            break;
+          }
+          case BOOL_CONST:
+            if (!get_varint(p, end, &value))
+              return false;
+            t.value.boolean = (value != 0);
+            break;
+          case ERROR: {
+            std::string msg;
+            if (!get_bytes(p, end, &msg))
+              return false;
+            t.value.error_msg = strdup((char *) msg.c_str());
+            break;
+          }
+        }
+        
+        tokens.push_back(t);
+      }
+      
+      return true;
+    }
+    
+    /* Loads a whole binary token stream: for each file, the "#name" line
+    lextest printed for it and then its chunk. */
+    static TokenBuffer *read_token_stream(FILE *in)
+    {
+      static std::vector<CoolToken> tokens;
+      static TokenBuffer buffer;
+      
+      std::string data;
+      char block[1 << 16];
+      size_t n;
+      
+      while ((n = fread(block, 1, sizeof(block), in)) > 0)
+        data.append(block, n);
+      
+      const char *p = data.data();
+      const char *end = p + data.size();
+      
+      while (p < end) {
+        if (*p == '#') {
+          const char *eol = (const char *) memchr(p, '\n', end - p);
+          if (eol == NULL)
+            eol = end;
+          
+          std::string line(p, eol);
+          size_t open = line.find('"');
+          size_t close = line.rfind('"');
+          
+          if (open != std::string::npos && close > open) {
+            CoolToken t;
+            t.kind = FILE_NAME_TOKEN;
+            t.lineno = 0;
+            t.value.error_msg = strdup((char *) line.substr(open + 1, close - open - 1).c_str());
+            tokens.push_back(t);
+          }
+          
+          p = (eol < end) ? eol + 1 : end;
+        }
+        else if (!read_token_chunk(p, end, tokens)) {
+          cerr << "Malformed binary token stream." << endl;
+          exit(1);
+        }
+      }
+      
+      buffer = TokenBuffer(tokens.data(), tokens.data() + tokens.size());
+      return &buffer;
+    }
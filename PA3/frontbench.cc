@@ -0,0 +1,455 @@
+//
+// frontbench measures the throughput of the lexer (PA2) and the parser
+// (PA3), run one after the other in this process.
+//
+// It builds corpora of 1, 10 and 100 MB by repeating the seed corpus
+// bench.cl, so results stay comparable from one change to the next.
+// Each corpus is lexed by a CoolLexer into a token array, which
+// cool_yyparse then reads through cool_token_buffer. With -f, the corpus
+// is split over that many files, which cool_lex_files lexes on its pool
+// of threads, and each file is then parsed in turn. Each size is run in
+// a child process of its own, so that memory left over from one size
+// doesn't hide what the next one needs. For each phase it reports:
+//
+//   - MB/s, tokens/s and AST nodes/s;
+//   - the peak RSS during the phase: VmHWM, reset at the start of the
+//     phase through /proc/self/clear_refs, or the peak of the child so
+//     far where that can't be reset;
+//   - the number and total size of allocations made through new.
+//
+// The AST nodes are counted in a dump_with_types listing, after the
+// parse has been timed.
+//
+// Before timing anything, it edits the seed through cool_lex_edit and
+// checks every result against lexing the edited text from scratch.
+//
+// frontbench.sh builds it and runs it from this directory:
+//
+//   ./frontbench.sh [--baseline REV] [-s MB]... [-f FILES] [seed.cl]
+//
+// Each -s replaces the default sizes with the given ones. --baseline
+// compares the lexer with the one of an earlier revision first.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <streambuf>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "cool-tree.h"
+#include "utilities.h"
+#include "scanner.h"
+
+// What the lexer and the parser expect the driver to define. The
+// parser defines curr_lineno itself.
+FILE *fin;
+static char bench_name[] = "<bench>";
+char *curr_filename = bench_name;
+
+extern Program ast_root;
+extern int omerrs;
+extern int curr_lineno;
+extern int cool_yyparse();
+
+// Counted from every thread, including cool_lex_files's pool.
+static std::atomic<unsigned long> alloc_count(0);
+static std::atomic<unsigned long> alloc_bytes(0);
+
+void *operator new(size_t size)
+{
+  alloc_count.fetch_add(1, std::memory_order_relaxed);
+  alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  void *p = malloc(size != 0 ? size : 1);
+  if (p == NULL)
+    throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+// A point in the run, to subtract from a later one.
+struct Sample {
+  double seconds;
+  unsigned long allocs;
+  unsigned long bytes;
+  long peak_kb;         // since the previous sample
+};
+
+// The peak RSS since the last call, from VmHWM. Writing 5 to clear_refs
+// resets VmHWM to the current RSS; if that fails, this is the peak of
+// the process so far.
+static long peak_rss_kb()
+{
+  long peak = -1;
+  char line[128];
+
+  FILE *f = fopen("/proc/self/status", "r");
+  if (f != NULL) {
+    while (fgets(line, sizeof(line), f) != NULL)
+      if (sscanf(line, "VmHWM: %ld kB", &peak) == 1)
+        break;
+    fclose(f);
+  }
+  if (peak < 0) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    peak = ru.ru_maxrss;
+  }
+
+  f = fopen("/proc/self/clear_refs", "w");
+  if (f != NULL) {
+    fputs("5", f);
+    fclose(f);
+  }
+
+  return peak;
+}
+
+static Sample sample()
+{
+  long peak = peak_rss_kb();
+
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+
+  Sample s = { tv.tv_sec + tv.tv_usec / 1e6, alloc_count.load(), alloc_bytes.load(), peak };
+  return s;
+}
+
+// Counts the nodes in a dump_with_types listing. Every node starts with
+// its line number, "#n", at the start of a (padded) line.
+class NodeCounter : public std::streambuf {
+public:
+  unsigned long nodes;
+
+  NodeCounter() : nodes(0), line_start(true) { }
+
+protected:
+  int overflow(int c)
+  {
+    if (c == '\n')
+      line_start = true;
+    else if (c != ' ') {
+      if (line_start && c == '#')
+        nodes++;
+      line_start = false;
+    }
+    return c;
+  }
+
+private:
+  bool line_start;
+};
+
+static void report(const char *phase, double mb, size_t tokens, unsigned long nodes,
+                   const Sample& from, const Sample& to)
+{
+  double secs = to.seconds - from.seconds;
+  if (secs <= 0)
+    secs = 1e-9;
+
+  printf("  %-6s %8.3f s %9.2f MB/s %12.0f tokens/s", phase, secs, mb / secs, tokens / secs);
+  if (nodes != 0)
+    printf(" %12.0f nodes/s", nodes / secs);
+  else
+    printf(" %21s", "");
+  printf("   peak RSS %8ld KB   %9lu allocs %10lu KB\n",
+         to.peak_kb, to.allocs - from.allocs, (to.bytes - from.bytes) / 1024);
+}
+
+// Writes copies of seed to nfiles temporary files, until together they
+// hold at least size bytes, and returns their total size.
+static size_t make_corpus(const std::string& seed, size_t size, int nfiles,
+                          std::vector<std::string>& names)
+{
+  size_t total = 0;
+
+  for (int i = 0; i < nfiles; i++) {
+    char name[] = "/tmp/frontbench.XXXXXX";
+    int fd = mkstemp(name);
+    if (fd < 0) {
+      perror("frontbench: mkstemp");
+      exit(1);
+    }
+    names.push_back(name);
+
+    FILE *f = fdopen(fd, "w");
+    size_t n = 0;
+    do {
+      fwrite(seed.data(), 1, seed.size(), f);
+      n += seed.size();
+    } while (n < size / nfiles);
+    fclose(f);
+
+    total += n;
+  }
+
+  return total;
+}
+
+static void bench(const std::string& seed, int megabytes, int nfiles)
+{
+  std::vector<std::string> names;
+  double mb = make_corpus(seed, (size_t) megabytes << 20, nfiles, names) / (double) (1 << 20);
+
+  std::vector<LexedFile> files;
+  Sample start = sample();
+
+  if (nfiles == 1) {
+    // The plain scanner, without cool_lex_files's tables and merge.
+    FILE *f = fopen(names[0].c_str(), "r");
+    CoolLexer lex;
+    if (f == NULL || !cool_lex_init(&lex, f)) {
+      cerr << "frontbench: can't set up the scanner." << endl;
+      exit(1);
+    }
+    files.resize(1);
+    cool_lex_all(&lex, files[0].tokens);
+    cool_lex_destroy(&lex);
+    fclose(f);
+  } else {
+    std::vector<char *> argv;
+    for (size_t i = 0; i < names.size(); i++)
+      argv.push_back((char *) names[i].c_str());
+    cool_lex_files(argv.size(), argv.data(), files);
+  }
+
+  Sample lexed = sample();
+
+  size_t ntokens = 0;
+  for (size_t i = 0; i < files.size(); i++) {
+    std::vector<CoolToken> &tokens = files[i].tokens;
+    for (size_t k = 0; k < tokens.size(); k++)
+      if (tokens[k].kind == ERROR) {
+        cerr << "frontbench: line " << tokens[k].lineno << ": " << tokens[k].value.error_msg << endl;
+        exit(1);
+      }
+    ntokens += tokens.size();
+    unlink(names[i].c_str());
+  }
+
+  std::vector<Program> programs;
+  omerrs = 0;
+  Sample checked = sample();
+
+  for (size_t i = 0; i < files.size(); i++) {
+    std::vector<CoolToken> &tokens = files[i].tokens;
+    TokenBuffer buffer(tokens.data(), tokens.data() + tokens.size());
+    cool_token_buffer = &buffer;
+    curr_lineno = 1;
+    cool_yyparse();
+    cool_token_buffer = NULL;
+    programs.push_back(ast_root);
+  }
+
+  Sample parsed = sample();
+
+  if (omerrs != 0) {
+    cerr << "frontbench: the corpus doesn't parse." << endl;
+    exit(1);
+  }
+
+  NodeCounter counter;
+  ostream dump(&counter);
+  for (size_t i = 0; i < programs.size(); i++)
+    programs[i]->dump_with_types(dump, 0);
+
+  printf("corpus %.1f MB in %d file(s), %lu tokens, %lu AST nodes\n", mb, nfiles,
+         (unsigned long) ntokens, counter.nodes);
+  report("lex", mb, ntokens, 0, start, lexed);
+  report("parse", mb, ntokens, counter.nodes, checked, parsed);
+}
+
+static bool same_token(const CoolToken& a, const CoolToken& b)
+{
+  if (a.kind != b.kind || a.lineno != b.lineno)
+    return false;
+
+  switch (a.kind) {
+  case TYPEID:
+  case OBJECTID:
+  case STR_CONST:
+  case INT_CONST:
+    return a.value.symbol == b.value.symbol;
+  case BOOL_CONST:
+    return a.value.boolean == b.value.boolean;
+  case ERROR:
+    return strcmp(a.value.error_msg, b.value.error_msg) == 0;
+  default:
+    return true;
+  }
+}
+
+static bool same_cache(const TokenCache& a, const TokenCache& b)
+{
+  if (a.tokens.size() != b.tokens.size() || a.ends != b.ends || a.lines.size() != b.lines.size())
+    return false;
+
+  for (size_t i = 0; i < a.tokens.size(); i++)
+    if (!same_token(a.tokens[i], b.tokens[i]))
+      return false;
+
+  for (size_t i = 0; i < a.lines.size(); i++)
+    if (a.lines[i].offset != b.lines[i].offset || a.lines[i].condition != b.lines[i].condition
+        || a.lines[i].comment_depth != b.lines[i].comment_depth)
+      return false;
+
+  return true;
+}
+
+// Applies an edit to cache and to expected, the text it should then
+// hold, and checks the result against a full relex of expected.
+static void check_edit(TokenCache& cache, std::string& expected, size_t start, size_t removed,
+                       const char *text)
+{
+  if (!cool_lex_edit(cache, start, removed, text, strlen(text))) {
+    cerr << "frontbench: cool_lex_edit refused an edit in range." << endl;
+    exit(1);
+  }
+  expected.replace(start, removed, text);
+
+  TokenCache full;
+  cool_lex_cache(full, expected.data(), expected.size());
+
+  if (cache.text != expected || full.text != expected) {
+    cerr << "frontbench: lexing the text at " << start << " changed it." << endl;
+    exit(1);
+  }
+  if (!same_cache(cache, full)) {
+    cerr << "frontbench: cool_lex_edit at " << start << " differs from a full relex." << endl;
+    exit(1);
+  }
+}
+
+// Edits the seed through cool_lex_edit. The scripted edits open, close
+// and change comments and strings that span lines, so each relex has
+// to run on past them before it falls back in step with the old
+// tokens; the rest are pseudo-random, and the same on every run.
+static void check_incremental(const std::string& seed)
+{
+  struct Edit {
+    const char *at;       // the edit is at the first occurrence of this
+    int offset;
+    size_t removed;
+    const char *text;
+  };
+  static const Edit edits[] = {
+    { "(* Comments nest", 3, 0, "x" },
+    { "(* Comments nest", 0, 0, "(* " },
+    { "*) and this one", 0, 2, "" },
+    { "over several lines", 0, 0, "*)\n" },
+    { "\"counter\\t", 1, 0, "\\\n" },
+    { "\"counter\\t", 1, 0, "\n" },
+    { "isNil() : Bool", 0, 0, "(*\n" },
+    { "tail() : List", 2, 1, "" },
+    { "class Main", 0, 0, "\"" },
+  };
+
+  TokenCache cache;
+  cool_lex_cache(cache, seed.data(), seed.size());
+  std::string expected = seed;
+  int n = 0;
+
+  if (cache.text != expected) {
+    cerr << "frontbench: lexing the seed changed it." << endl;
+    exit(1);
+  }
+
+  for (size_t i = 0; i < sizeof(edits) / sizeof(edits[0]); i++) {
+    size_t at = expected.find(edits[i].at);
+    if (at == std::string::npos)
+      continue;
+    check_edit(cache, expected, at + edits[i].offset, edits[i].removed, edits[i].text);
+    n++;
+  }
+
+  static const char *const pieces[] = { "(*", "*)", "\"", "\\", "\n", "--", " x", "1" };
+  unsigned r = 12345;
+
+  for (int i = 0; i < 200; i++, n++) {
+    r = r * 1103515245 + 12345;
+    size_t start = (r >> 8) % (cache.text.size() + 1);
+    size_t removed = std::min<size_t>((r >> 4) % 4, cache.text.size() - start);
+    check_edit(cache, expected, start, removed, pieces[r % (sizeof(pieces) / sizeof(pieces[0]))]);
+  }
+
+  if (cool_lex_edit(cache, cache.text.size() + 1, 0, "", 0)
+      || cool_lex_edit(cache, 0, cache.text.size() + 1, "", 0)) {
+    cerr << "frontbench: cool_lex_edit took an edit out of range." << endl;
+    exit(1);
+  }
+
+  printf("%d incremental edits match a full relex\n", n);
+}
+
+int main(int argc, char **argv)
+{
+  std::vector<int> sizes;
+  int nfiles = 1;
+  int c;
+
+  while ((c = getopt(argc, argv, "s:f:")) != -1) {
+    if (c == 's' && atoi(optarg) > 0)
+      sizes.push_back(atoi(optarg));
+    else if (c == 'f' && atoi(optarg) > 0)
+      nfiles = atoi(optarg);
+    else {
+      cerr << "usage: frontbench [-s MB]... [-f FILES] [seed.cl]" << endl;
+      exit(1);
+    }
+  }
+  if (sizes.empty()) {
+    sizes.push_back(1);
+    sizes.push_back(10);
+    sizes.push_back(100);
+  }
+
+  const char *name = (optind < argc) ? argv[optind] : "bench.cl";
+  FILE *in = fopen(name, "r");
+  if (in == NULL) {
+    cerr << "frontbench: can't open " << name << endl;
+    exit(1);
+  }
+
+  std::string seed;
+  char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), in)) > 0)
+    seed.append(buf, n);
+  fclose(in);
+
+  check_incremental(seed);
+
+  fflush(stdout);
+
+  for (size_t i = 0; i < sizes.size(); i++) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      perror("frontbench: fork");
+      exit(1);
+    }
+    if (pid == 0) {
+      bench(seed, sizes[i], nfiles);
+      fflush(stdout);
+      _exit(0);
+    }
+
+    int status;
+    if (waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      exit(1);
+  }
+
+  return 0;
+}
@@ -0,0 +1,145 @@
+#!/bin/sh
+#
+# Builds frontbench and runs it from this directory. The arguments are
+# passed on to it:
+#
+#   ./frontbench.sh [--baseline REV] [-s MB]... [-f FILES] [seed.cl]
+#
+# The Makefiles come from the course and have no target for it, so this
+# builds the lexer and the parser it needs on the side, in a temporary
+# directory, from PA2/cool.flex and cool.y. The support sources and the
+# headers come from the course directory, found through the symlinks
+# here; set COOL_DIR to use another one. It needs flex and bison.
+#
+# It also builds PA2/lexstream, and checks that the parser reads the
+# same AST from its binary token stream as from lextest's text one, for
+# bench.cl and good.cl together.
+#
+# With --baseline, it first compares the lexer of this tree with the one
+# of git revision REV, e.g. "--baseline 7e8d1d7^" for the lexer before
+# keywords were hashed. Older revisions don't have all of the scanner
+# interface frontbench uses, so both are built as the course's lexer
+# driver, lextest, and timed on the same corpus of BASELINE_MB (10 by
+# default) copies of the seed, with their output thrown away. The best
+# of three runs is reported for each.
+#
+
+set -e
+
+here=$(cd "$(dirname "$0")" && pwd)
+root=$(dirname "$here")
+
+if [ -z "$COOL_DIR" ]; then
+  # tree.cc -> $COOL_DIR/src/PA3/tree.cc
+  COOL_DIR=$(dirname "$(dirname "$(dirname "$(readlink "$here/tree.cc")")")")
+fi
+if [ ! -d "$COOL_DIR/include/PA3" ]; then
+  echo "frontbench.sh: no course directory at '$COOL_DIR'; set COOL_DIR." >&2
+  exit 1
+fi
+for tool in flex bison; do
+  if ! command -v $tool > /dev/null; then
+    echo "frontbench.sh: $tool is needed to build the lexer and the parser." >&2
+    exit 1
+  fi
+done
+
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:-"-O2 -std=c++11 -Wall -Wno-unused -Wno-deprecated"}
+
+baseline=
+if [ "$1" = "--baseline" ]; then
+  if [ $# -lt 2 ]; then
+    echo "usage: frontbench.sh [--baseline REV] [-s MB]... [-f FILES] [seed.cl]" >&2
+    exit 1
+  fi
+  baseline=$2
+  shift 2
+fi
+
+build=$(mktemp -d /tmp/frontbench.build.XXXXXX)
+trap 'if [ -d "$build/base" ]; then git -C "$root" worktree remove --force "$build/base"; fi; rm -rf "$build"' EXIT
+
+# build_lexer TREE OUT PA: cool.flex of TREE, compiled into OUT against
+# the course headers of PA.
+build_lexer() {
+  mkdir -p "$2"
+  flex -o"$2/cool-lex.cc" "$1/PA2/cool.flex"
+  $CXX $CXXFLAGS -I"$1/PA2" -I"$COOL_DIR/include/$3" -c "$2/cool-lex.cc" -o "$2/cool-lex.o"
+}
+
+# build_lextest TREE OUT: the course's lexer driver, linked with the
+# lexer of TREE.
+build_lextest() {
+  build_lexer "$1" "$2" PA2
+  for f in lextest handle_flags stringtab utilities; do
+    $CXX $CXXFLAGS -I"$COOL_DIR/include/PA2" -c "$COOL_DIR/src/PA2/$f.cc" -o "$2/$f.o"
+  done
+  $CXX -o "$2/lexer" "$2"/*.o -pthread
+}
+
+# best_time PROGRAM FILE: the best of three runs, in seconds.
+best_time() {
+  for run in 1 2 3; do
+    start=$(date +%s.%N)
+    "$1" "$2" > /dev/null
+    end=$(date +%s.%N)
+    echo "$start $end"
+  done | awk 'NR == 1 || $2 - $1 < best { best = $2 - $1 } END { printf "%.3f\n", best }'
+}
+
+if [ -n "$baseline" ]; then
+  git -C "$root" worktree add --detach --quiet "$build/base" "$baseline"
+  build_lextest "$build/base" "$build/lextest-base"
+  build_lextest "$root" "$build/lextest"
+
+  : > "$build/corpus.cl"
+  while [ "$(wc -c < "$build/corpus.cl")" -lt $((${BASELINE_MB:-10} << 20)) ]; do
+    cat "$here/bench.cl" "$here/bench.cl" "$here/bench.cl" "$here/bench.cl" >> "$build/corpus.cl"
+  done
+
+  base=$(best_time "$build/lextest-base/lexer" "$build/corpus.cl")
+  this=$(best_time "$build/lextest/lexer" "$build/corpus.cl")
+  echo "lexer, ${BASELINE_MB:-10} MB: $baseline ${base} s, this tree ${this} s"
+fi
+
+# The parser, from cool.y, and what it needs of the course's sources.
+mkdir -p "$build/parser"
+(cd "$build/parser" && bison -d -v -y -b cool --debug -p cool_yy "$here/cool.y" && mv cool.tab.c cool-parse.cc)
+$CXX $CXXFLAGS -I"$here" -I"$COOL_DIR/include/PA3" -c "$build/parser/cool-parse.cc" -o "$build/parser/cool-parse.o"
+for f in cool-tree tree dumptype stringtab utilities; do
+  $CXX $CXXFLAGS -I"$here" -I"$COOL_DIR/include/PA3" -c "$here/$f.cc" -o "$build/parser/$f.o"
+done
+
+# The course's parser driver, which reads tokens as text, or as a binary
+# stream with COOL_LEX_BINARY set.
+mkdir -p "$build/parser-phase"
+for f in parser-phase handle_flags tokens-lex; do
+  $CXX $CXXFLAGS -I"$here" -I"$COOL_DIR/include/PA3" -c "$here/$f.cc" -o "$build/parser-phase/$f.o"
+done
+$CXX -o "$build/parser-phase/parser" "$build/parser-phase"/*.o "$build/parser"/*.o
+
+# lexstream, and lextest for the text stream to compare it with.
+if [ ! -x "$build/lextest/lexer" ]; then
+  build_lextest "$root" "$build/lextest"
+fi
+mkdir -p "$build/lexstream"
+$CXX $CXXFLAGS -I"$root/PA2" -I"$COOL_DIR/include/PA2" -c "$root/PA2/lexstream.cc" -o "$build/lexstream/lexstream.o"
+$CXX -o "$root/PA2/lexstream" "$build/lexstream/lexstream.o" "$build/lextest/cool-lex.o" \
+  "$build/lextest/stringtab.o" "$build/lextest/utilities.o" -pthread
+
+(cd "$here" && "$build/lextest/lexer" bench.cl good.cl | "$build/parser-phase/parser") > "$build/text.ast"
+(cd "$here" && "$root/PA2/lexstream" bench.cl good.cl | COOL_LEX_BINARY=1 "$build/parser-phase/parser") > "$build/binary.ast"
+if ! cmp -s "$build/text.ast" "$build/binary.ast"; then
+  echo "frontbench.sh: the parser reads a different AST from lexstream's binary stream." >&2
+  diff "$build/text.ast" "$build/binary.ast" | head -20 >&2
+  exit 1
+fi
+echo "text and binary token streams parse to the same AST"
+
+build_lexer "$root" "$build/frontbench" PA3
+$CXX $CXXFLAGS -I"$here" -I"$root/PA2" -I"$COOL_DIR/include/PA3" -c "$here/frontbench.cc" -o "$build/frontbench/frontbench.o"
+$CXX -o "$here/frontbench" "$build/frontbench"/*.o "$build/parser"/*.o -pthread
+
+cd "$here"
+./frontbench "$@"
@@ -5,6 +5,7 @@
 #define COOL_TREE_HANDCODE_H
 
 #include <iostream>
+#include <vector>
 #include "tree.h"
 #include "cool.h"
 #include "stringtab.h"
@@ -79,13 +80,15 @@ Features get_features() { return features; }
 virtual void dump_with_types(ostream&,int) = 0;     \
 virtual void semant(ClassTable*) = 0;      \
 virtual Symbol get_name() = 0; \
-virtual void publish(ClassTable*) = 0;
+virtual void publish(ClassTable*) = 0; \
+virtual void walk(std::vector<Expression>&) = 0;
 
 #define Feature_SHARED_EXTRAS                                       \
 void dump_with_types(ostream&,int);                         \
 void semant(ClassTable*);                   \
 Symbol get_name() { return name; }     \
-void publish(ClassTable*);
+void publish(ClassTable*);                  \
+void walk(std::vector<Expression>&);
 
 
 #define Method_EXTRAS           \
@@ -95,6 +98,9 @@ virtual Formals get_formals() = 0;
 Symbol get_return_type() { return return_type; }    \
 Formals get_formals() { return formals; }
 
+#define attr_EXTRAS                             \
+Symbol get_type_decl() { return type_decl; }
+
 
 
 
@@ -115,13 +121,15 @@ Symbol get_name() { return name; }
 #define Case_EXTRAS                             \
 virtual void dump_with_types(ostream& ,int) = 0; \
 virtual Symbol semant(ClassTable*) = 0;   \
-virtual Symbol get_type() = 0;
+virtual Symbol get_type() = 0;           \
+virtual void walk(std::vector<Expression>&) = 0;
 
 
 #define branch_EXTRAS                                   \
 void dump_with_types(ostream& ,int);                \
 Symbol semant(ClassTable*);              \
-Symbol get_type() { return type_decl; }
+Symbol get_type() { return type_decl; }  \
+void walk(std::vector<Expression>&);
 
 
 #define Expression_EXTRAS                    \
@@ -131,11 +139,13 @@ Expression set_type(Symbol s) { type = s; return this; } \
 virtual void dump_with_types(ostream&,int) = 0;  \
 void dump_type(ostream&, int);               \
 Expression_class() { type = (Symbol) NULL; } \
-virtual Symbol semant(ClassTable*) = 0;    
+virtual Symbol semant(ClassTable*) = 0;      \
+virtual void walk(std::vector<Expression>&) = 0;
 
 
 #define Expression_SHARED_EXTRAS           \
 void dump_with_types(ostream&,int);         \
-Symbol semant(ClassTable*);
+Symbol semant(ClassTable*);                 \
+void walk(std::vector<Expression>&);
 
 #endif
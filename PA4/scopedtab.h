@@ -0,0 +1,149 @@
+//
+// ScopedTable is a drop-in replacement for SymbolTable (symtab.h) with
+// the same enterscope/exitscope/addid/lookup/probe interface.
+//
+// SymbolTable keeps a list of scopes, each a list of bindings, so a
+// lookup is linear in the number of visible bindings. ScopedTable keeps
+// every visible binding in one hash map and records what each addid
+// shadowed in an undo log. exitscope replays the log back to the mark
+// taken by the matching enterscope, so lookup, probe and scope entry
+// are O(1) and scope exit is O(1) per binding made in that scope.
+//
+
+#ifndef _SCOPEDTAB_H_
+#define _SCOPEDTAB_H_
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <unordered_map>
+#include <vector>
+#include "cool-io.h"
+
+template <class SYM, class DAT>
+class ScopedTable
+{
+private:
+   struct Binding {
+      DAT *info;
+      size_t scope;        // nesting depth at which the binding was made
+   };
+
+   struct Undo {
+      SYM id;
+      bool shadowed;       // was there a binding before this addid?
+      Binding old;
+   };
+
+   std::unordered_map<SYM, Binding> tbl;
+   std::vector<Undo> log;
+   std::vector<size_t> marks;    // log size at each enterscope
+
+   size_t nentered;              // enterscope calls since reset_stats
+   size_t npeak;                 // most live bindings since reset_stats
+
+public:
+   ScopedTable() : nentered(0), npeak(0) { }
+
+   // Drop all scopes and bindings.
+   void fresh()
+   {
+      tbl.clear();
+      log.clear();
+      marks.clear();
+   }
+
+   void enterscope()
+   {
+      marks.push_back(log.size());
+      nentered++;
+   }
+
+   // Undo every addid made since the matching enterscope.
+   void exitscope()
+   {
+      // It is an error to exit a scope that doesn't exist.
+      if (marks.empty()) {
+         cerr << "exitscope: Can't remove scope from an empty symbol table." << endl;
+         exit(1);
+      }
+
+      size_t mark = marks.back();
+      marks.pop_back();
+
+      while (log.size() > mark) {
+         Undo &u = log.back();
+         if (u.shadowed)
+            tbl[u.id] = u.old;
+         else
+            tbl.erase(u.id);
+         log.pop_back();
+      }
+   }
+
+   void addid(SYM s, DAT *i)
+   {
+      // There must be at least one scope to add a symbol.
+      if (marks.empty()) {
+         cerr << "addid: Can't add a symbol without a scope." << endl;
+         exit(1);
+      }
+
+      Undo u;
+      u.id = s;
+
+      typename std::unordered_map<SYM, Binding>::iterator it = tbl.find(s);
+      u.shadowed = (it != tbl.end());
+      if (u.shadowed)
+         u.old = it->second;
+      log.push_back(u);
+
+      Binding b;
+      b.info = i;
+      b.scope = marks.size();
+      tbl[s] = b;
+
+      if (log.size() > npeak)
+         npeak = log.size();
+   }
+
+   // Find the innermost binding of s, or NULL.
+   DAT *lookup(SYM s)
+   {
+      typename std::unordered_map<SYM, Binding>::const_iterator it = tbl.find(s);
+      return (it == tbl.end()) ? NULL : it->second.info;
+   }
+
+   // Like lookup, but only in the innermost scope.
+   DAT *probe(SYM s)
+   {
+      if (marks.empty()) {
+         cerr << "probe: No scope in symbol table." << endl;
+         exit(1);
+      }
+
+      typename std::unordered_map<SYM, Binding>::const_iterator it = tbl.find(s);
+      if (it == tbl.end() || it->second.scope != marks.size())
+         return NULL;
+      return it->second.info;
+   }
+
+   // Usage counters, for profiling. Live bindings include shadowed ones.
+   size_t scopes_entered() const { return nentered; }
+   size_t peak_bindings() const { return npeak; }
+
+   void reset_stats()
+   {
+      nentered = 0;
+      npeak = log.size();
+   }
+
+   // Print the visible bindings; for debugging.
+   void dump()
+   {
+      for (typename std::unordered_map<SYM, Binding>::const_iterator it = tbl.begin();
+           it != tbl.end(); ++it)
+         cerr << "  " << it->first << " (scope " << it->second.scope << ")" << endl;
+   }
+};
+
+#endif
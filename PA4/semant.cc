@@ -3,6 +3,15 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "semant.h"
 #include "utilities.h"
 
@@ -87,105 +96,265 @@ static void initialize_constants(void)
 
 
 
-ClassTable::ClassTable(Classes classes) : semant_errors(0) , error_stream(cerr) {
+thread_local CheckState *ClassTable::local_state_ = NULL;
+
+ClassTable::ClassTable(Classes classes) : error_stream(cerr), main_state_(&cerr),
+    stats_enabled_(getenv("COOL_SEMANT_STATS") != NULL), phase_clock_(std::chrono::steady_clock::now()) {
 
     /* Fill this in */
     install_basic_classes();
+    install_interface_classes();
                                  
+    classes_ = append_Classes(classes_, interfaces_);
     classes_ = append_Classes(classes_, classes);
 
-    SymbolTable <Symbol, Entry> class_set;
-    class_set.enterscope();
+    /*
+     * Every class gets a dense type ID in declaration order, after the
+     * IDs reserved for SELF_TYPE and No_type. The basic classes come
+     * first, so redefining one of them is reported like any other
+     * duplicate.
+     */
+    type_ids_.reserve(classes_->len() + FIRST_CLASS_ID);
+    type_ids_[SELF_TYPE] = SELF_TYPE_ID;
+    type_ids_[No_type] = NO_TYPE_ID;
+    type_names_.push_back(SELF_TYPE);
+    type_names_.push_back(No_type);
+    classes_by_id_.push_back(NULL);
+    classes_by_id_.push_back(NULL);
 
-    class_set.addid(Object, Object);
-    class_set.addid(Int, Int);
-    class_set.addid(Str, Str);
-    class_set.addid(IO, IO);
-    class_set.addid(SELF_TYPE, SELF_TYPE);
-    
-    for (int i = classes->first(); classes->more(i); i = classes->next(i))
+    for (int i = classes_->first(); classes_->more(i); i = classes_->next(i))
     {
-        Class_ c = classes->nth(i);
+        Class_ c = classes_->nth(i);
 
-        if (class_set.lookup(c->get_name()) != NULL)
+        if (type_ids_.count(c->get_name()) != 0)
         {
             semant_error(c) << c->get_name() << " already defined" << std::endl;
             return;
         }
 
-        class_set.addid(c->get_name(), c->get_name());
-        
-        if (check_class(c))
-        {
-            semant_error(c) << "cyclic dependency detected" << std::endl;
-            return;
-        }
+        type_ids_[c->get_name()] = (TypeId) type_names_.size();
+        type_names_.push_back(c->get_name());
+        classes_by_id_.push_back(c);
     }
 
+    check_inheritance(append_Classes(interfaces_, classes));
+
+    if (errors())
+        return;
+
     if (get_class(Main) == NULL)
     {
         semant_error() << "Class Main is not defined." << std::endl;
         return;
     }
+
+    number_classes();
+}
+
+/*
+ * Numbers the inheritance tree with an iterative DFS from Object so that
+ * conforms is two integer comparisons, and fills in the ancestor jump
+ * tables used by lub. Method tables and attribute environments are
+ * built on entry, when the parent's are already complete. Only called
+ * once the graph is known to be a tree rooted at Object.
+ */
+void ClassTable::number_classes()
+{
+    TypeId n = (TypeId) classes_by_id_.size();
+    std::vector<std::vector<TypeId> > children(n);
+
+    for (TypeId t = FIRST_CLASS_ID; t < n; t++)
+    {
+        if (type_names_[t] != Object)
+            children[get_type_id(classes_by_id_[t]->get_parent())].push_back(t);
+    }
+
+    class_nodes_.resize(n);
+    method_tables_.resize(n);
+    attr_envs_.resize(n);
+
+    TypeId root = get_type_id(Object);
+    int clock = 0;
+    std::vector<std::pair<TypeId, size_t> > stack;
+
+    class_nodes_[root].enter = clock++;
+    class_nodes_[root].depth = 0;
+    build_method_table(root);
+    build_attr_env(root);
+    stack.push_back(std::make_pair(root, (size_t) 0));
+
+    while (!stack.empty())
+    {
+        TypeId t = stack.back().first;
+
+        if (stack.back().second < children[t].size())
+        {
+            TypeId kid = children[t][stack.back().second++];
+            ClassNode &node = class_nodes_[kid];
+
+            node.enter = clock++;
+            node.depth = class_nodes_[t].depth + 1;
+            node.up.push_back(t);
+
+            for (size_t k = 1; k - 1 < class_nodes_[node.up[k - 1]].up.size(); k++)
+                node.up.push_back(class_nodes_[node.up[k - 1]].up[k - 1]);
+
+            build_method_table(kid);
+            build_attr_env(kid);
+            stack.push_back(std::make_pair(kid, (size_t) 0));
+        }
+        else
+        {
+            class_nodes_[t].exit = clock++;
+            stack.pop_back();
+        }
+    }
+}
+
+/*
+ * A class's own methods shadow the inherited ones. insert() keeps the
+ * first definition, so a method defined twice in one class resolves to
+ * the earlier one as before.
+ */
+void ClassTable::build_method_table(TypeId t)
+{
+    MethodTable &table = method_tables_[t];
+    Features features = classes_by_id_[t]->get_features();
+
+    for (int i = features->first(); features->more(i); i = features->next(i))
+    {
+        method_class *method = dynamic_cast<method_class*>(features->nth(i));
+        count(&SemantStats::casts);
+
+        if (method != NULL)
+            table.insert(std::make_pair(method->get_name(), method));
+    }
+
+    if (!class_nodes_[t].up.empty())
+    {
+        const MethodTable &inherited = method_tables_[class_nodes_[t].up[0]];
+        table.insert(inherited.begin(), inherited.end());
+    }
+}
+
+/*
+ * Like method tables, the first definition of an attribute wins. self
+ * is left out; attr_class::semant reports it.
+ */
+void ClassTable::build_attr_env(TypeId t)
+{
+    AttrEnv &env = attr_envs_[t];
+    Features features = classes_by_id_[t]->get_features();
+
+    env.parent = class_nodes_[t].up.empty() ? NULL : &attr_envs_[class_nodes_[t].up[0]];
+
+    for (int i = features->first(); features->more(i); i = features->next(i))
+    {
+        attr_class *attr = dynamic_cast<attr_class*>(features->nth(i));
+        count(&SemantStats::casts);
+
+        if (attr != NULL && attr->get_name() != self)
+            env.attrs.insert(std::make_pair(attr->get_name(), attr));
+    }
+
+    env.visible = env.attrs;
+    if (env.parent != NULL)
+        env.visible.insert(env.parent->visible.begin(), env.parent->visible.end());
+}
+
+attr_class* AttrEnv::lookup(Symbol name) const
+{
+    std::unordered_map<Symbol, attr_class*>::const_iterator it = visible.find(name);
+    return it != visible.end() ? it->second : NULL;
+}
+
+TypeId ClassTable::get_type_id(Symbol name)
+{
+    TypeIds::const_iterator it = type_ids_.find(name);
+    TypeId t = (it == type_ids_.end()) ? INVALID_TYPE_ID : it->second;
+
+    DepSet *deps = state().deps;
+    if (deps != NULL)
+        deps->add(name, t);
+
+    return t;
+}
+
+void ClassTable::set_current_class(Class_ c)
+{
+    state().current_class = c;
+    state().current_class_id = get_type_id(c->get_name());
 }
 
+/*
+ * SELF_TYPE and self resolve to the class currently being checked.
+ */
 Class_ ClassTable::get_class(Symbol name)
 { 
+    count(&SemantStats::get_class);
+
     if (name == SELF_TYPE || name == self)
-        name = symbols_.lookup(self);
+        return state().current_class;
 
-    for (int i = classes_->first(); classes_->more(i); i = classes_->next(i))
-    {
-        Class_ c = classes_->nth(i);
-        if (name == c->get_name()) 
-            return c;
-    }
+    TypeId t = get_type_id(name);
 
-    return NULL;
+    return (t == INVALID_TYPE_ID) ? NULL : classes_by_id_[t];
 }
 
 /* 
- * This method uses a bruteforce approach to check for cycles. 
- * In addition it checks for invalid parents like Int, Str, Bool and undefined classes.
+ * Validates the parent edges of the user classes in a single pass.
+ * Every class has exactly one parent, so following parents from each
+ * unvisited class either reaches a finished class or runs into the
+ * current path again, in which case the classes from that point on
+ * form a cycle. Each class is walked at most once.
  */
 
-bool ClassTable::check_class(Class_ c)
+void ClassTable::check_inheritance(Classes classes)
 {
-    int n = classes_->len();
+    enum { UNVISITED, ON_PATH, DONE };
 
-    int i = 0;
+    std::unordered_map<Symbol, int> state;
+    std::vector<Class_> path;
 
-    Class_ parent = get_class(c->get_parent());
-     
-    if (parent == NULL)
+    for (int i = classes->first(); classes->more(i); i = classes->next(i))
     {
-        semant_error(c) << "undefined parent" << std::endl; 
-        return true;
+        Class_ c = classes->nth(i);
+        Symbol parent = c->get_parent();
+
+        if (parent == Str 
+                || parent == Bool 
+                || parent == Int
+                || parent == SELF_TYPE)
+            semant_error(c) << "not allowed to derive from basic classes" << std::endl;
+        else if (get_class(parent) == NULL)
+            semant_error(c) << "undefined parent" << std::endl; 
     }
 
-    while (parent->get_name() != Object)
+    for (int i = classes->first(); classes->more(i); i = classes->next(i))
     {
-        if (parent->get_name() == Str 
-                || parent->get_name() == Bool 
-                || parent->get_name() == Int
-                || parent->get_name() == SELF_TYPE)
-            semant_error(c) << "not allowed to derive from basic classes" << std::endl;
+        Class_ c = classes->nth(i);
 
-        i++;
-        
-        if (i > n) 
-            return true;
-        
-        parent = get_class(parent->get_parent());
-        
-        if (parent == NULL)
+        path.clear();
+        while (c != NULL && c->get_name() != Object && state[c->get_name()] == UNVISITED)
         {
-            semant_error(c) << "undefined parent" << std::endl;   
-            return true;
+            state[c->get_name()] = ON_PATH;
+            path.push_back(c);
+            c = get_class(c->get_parent());
+        }
+
+        if (c != NULL && state[c->get_name()] == ON_PATH)
+        {
+            size_t j = 0;
+            while (path[j] != c)
+                j++;
+
+            for (; j < path.size(); j++)
+                semant_error(path[j]) << "cyclic dependency detected" << std::endl;
         }
-    }
 
-    return false;
+        for (size_t j = 0; j < path.size(); j++)
+            state[path[j]->get_name()] = DONE;
+    }
 }
 
 Symbol ClassTable::get_return_type(Symbol c, Symbol m)
@@ -195,84 +364,149 @@ Symbol ClassTable::get_return_type(Symbol c, Symbol m)
 
 method_class* ClassTable::get_method(Class_ c, Symbol m)
 {
-    for (int i = c->get_features()->first(); c->get_features()->more(i); i = c->get_features()->next(i))
-    {
-        method_class *method = dynamic_cast<method_class*>(c->get_features()->nth(i));
-        
-        if (method == NULL) 
-            continue;
+    if (c == NULL)
+        return NULL;
 
-        if (method->get_name() == m)
-        {
-            return method;
+    return get_method(get_type_id(c->get_name()), m);
+}
 
-        }
-    }
-    
-    Class_ p = get_class(c->get_parent());
-    return (p == NULL) ? NULL : get_method(p, m);
+method_class* ClassTable::get_method(TypeId t, Symbol m)
+{
+    count(&SemantStats::get_method);
+    t = resolve(t);
+
+    if (!is_class_id(t))
+        return NULL;
+
+    MethodTable::const_iterator it = method_tables_[t].find(m);
+
+    return (it == method_tables_[t].end()) ? NULL : it->second;
 }
 
 bool ClassTable::is_subclass(Class_ c1, Class_ c2)
 {
-    if (c1->get_name() == c2->get_name())
-        return true;
+    if (c1 == NULL || c2 == NULL)
+        return false;
 
-    Class_ p = get_class(c1->get_parent());
+    return conforms(get_type_id(c1->get_name()), get_type_id(c2->get_name()));
+}
 
-    return (p == NULL) ? false : is_subclass(p, c2);
+bool ClassTable::conforms(Symbol t1, Symbol t2)
+{
+    return conforms(get_type_id(t1), get_type_id(t2));
 }
 
 /*
- * One-off error was here, had to add and check the class itself, too...
- * This method should be changed to a good graph-algorithm for efficiency.
+ * SELF_TYPE is taken as the current class on both sides; anything that
+ * is not a class conforms to nothing.
  */
-Symbol ClassTable::get_lub(Class_ c1, Class_ c2)
+bool ClassTable::conforms(TypeId t1, TypeId t2)
 {
-    if (c1->get_name() == c2->get_name())
-        return c1->get_name();
-    
-    SymbolTable<Symbol, Entry> parents;
-    parents.enterscope();
-    parents.addid(c1->get_name(), c1->get_name());
+    count(&SemantStats::conforms);
+    t1 = resolve(t1);
+    t2 = resolve(t2);
 
-    Class_ p1 = get_class(c1->get_parent());
-    while (p1 != NULL)
-    {
-        parents.addid(p1->get_name(), p1->get_name());
-        p1 = get_class(p1->get_parent());
-    }
+    if (!is_class_id(t1) || !is_class_id(t2))
+        return false;
+
+    return t1 == t2 || below(t1, t2);
+}
+
+/*
+ * Whether class t1 is a proper subclass of class t2. Both must already
+ * be resolved class IDs.
+ */
+bool ClassTable::below(TypeId t1, TypeId t2)
+{
+    const ClassNode &n1 = class_nodes_[t1];
+    const ClassNode &n2 = class_nodes_[t2];
+
+    return n2.enter < n1.enter && n1.exit < n2.exit;
+}
+
+Symbol ClassTable::lub(Symbol t1, Symbol t2)
+{
+    return type_names_[lub(get_type_id(t1), get_type_id(t2))];
+}
+
+/*
+ * Least common ancestor by binary lifting: climb from t1 in decreasing
+ * powers of two while the ancestor reached is still not above t2.
+ */
+TypeId ClassTable::lub(TypeId t1, TypeId t2)
+{
+    count(&SemantStats::lub);
+    t1 = resolve(t1);
+    t2 = resolve(t2);
+
+    if (!is_class_id(t1) || !is_class_id(t2))
+        return get_type_id(Object);
+
+    if (t1 == t2 || below(t1, t2))
+        return t2;
+
+    if (below(t2, t1))
+        return t1;
 
-    Class_ p2 = c2;
-    while (p2 != NULL)
+    TypeId a = t1;
+
+    for (int k = (int) class_nodes_[a].up.size() - 1; k >= 0; k--)
     {
-        if (parents.lookup(p2->get_name()) != NULL)
-            return p2->get_name();
+        const std::vector<TypeId> &up = class_nodes_[a].up;
 
-        p2 = get_class(p2->get_parent());
+        if (k < (int) up.size() && t2 != up[k] && !below(t2, up[k]))
+            a = up[k];
     }
 
-    return Object;
+    return class_nodes_[a].up[0];
+}
+
+std::vector<bool>& ClassTable::enter_case()
+{
+    CheckState &st = state();
+
+    if (st.case_depth == st.case_branches.size())
+        st.case_branches.push_back(std::vector<bool>(classes_by_id_.size(), false));
+
+    return st.case_branches[st.case_depth++];
 }
 
+/*
+ * Makes the precomputed attribute environment of c current and reports
+ * attributes of c that clash with earlier or inherited ones. Inherited
+ * attributes are not re-inserted into symbols(); lookup_variable falls
+ * back to the environment instead.
+ */
 void ClassTable::publish_variables(Class_ c)
 {
+    state().current_env = &attr_envs_[get_type_id(c->get_name())];
+
     Features features = c->get_features();
     for (int i = features->first(); features->more(i); i = features->next(i))
     {
         attr_class *attr = dynamic_cast<attr_class*>(features->nth(i));
+        count(&SemantStats::casts);
         
         if (attr == NULL)
             continue;
 
         attr->publish(this);
     }
+}
+
+Symbol ClassTable::lookup_variable(Symbol name)
+{
+    CheckState &st = state();
+    Symbol type = st.symbols.lookup(name);
 
-    Class_ p = get_class(c->get_parent());
-    if (p != NULL) 
+    if (type == NULL && st.current_env != NULL)
     {
-        publish_variables(p);
+        attr_class *attr = st.current_env->lookup(name);
+        if (attr != NULL)
+            type = attr->get_type_decl();
     }
+
+    return type;
 }
 
 void ClassTable::publish_variables(method_class* m)
@@ -282,7 +516,7 @@ void ClassTable::publish_variables(method_class* m)
 
 void method_class::publish(ClassTableP classtable)
 {
-    SymbolTable<Symbol, Entry> params;
+    ScopedTable<Symbol, Entry> params;
     params.enterscope();
 
     for (int i = formals->first(); formals->more(i); i = formals->next(i))
@@ -307,15 +541,19 @@ void method_class::publish(ClassTableP classtable)
 
 void attr_class::publish(ClassTableP classtable)
 {
-    if (classtable->symbols_.lookup(name) != NULL)
+    if (name == self)
+        return;
+
+    const AttrEnv *env = classtable->get_attr_env();
+
+    if (env->attrs.find(name)->second != this
+            || (env->parent != NULL && env->parent->lookup(name) != NULL))
     {    
         classtable->semant_error(classtable->get_current_class()) << 
             "Attribute " << name << " already defined" 
             << std::endl;
         return;    
     }
-
-    classtable->symbols_.addid(name, type_decl);
 }
 
 void formal_class::publish(ClassTableP classtable)
@@ -327,147 +565,1056 @@ void formal_class::publish(ClassTableP classtable)
             << std::endl;
         return;          
     }
-    classtable->symbols_.addid(name, type_decl);
+    classtable->symbols().addid(name, type_decl);
 }
 
-void ClassTable::install_basic_classes() {
+void ClassTable::install_basic_classes() {
+
+    // The tree package uses these globals to annotate the classes built below.
+   // curr_lineno  = 0;
+    Symbol filename = stringtable.add_string("<basic class>");
+    
+    // The following demonstrates how to create dummy parse trees to
+    // refer to basic Cool classes.  There's no need for method
+    // bodies -- these are already built into the runtime system.
+    
+    // IMPORTANT: The results of the following expressions are
+    // stored in local variables.  You will want to do something
+    // with those variables at the end of this method to make this
+    // code meaningful.
+
+    // 
+    // The Object class has no parent class. Its methods are
+    //        abort() : Object    aborts the program
+    //        type_name() : Str   returns a string representation of class name
+    //        copy() : SELF_TYPE  returns a copy of the object
+    //
+    // There is no need for method bodies in the basic classes---these
+    // are already built in to the runtime system.
+
+    Class_ Object_class =
+	class_(Object, 
+	       No_class,
+	       append_Features(
+			       append_Features(
+					       single_Features(method(cool_abort, nil_Formals(), Object, no_expr())),
+					       single_Features(method(type_name, nil_Formals(), Str, no_expr()))),
+			       single_Features(method(copy, nil_Formals(), SELF_TYPE, no_expr()))),
+	       filename);
+
+    // 
+    // The IO class inherits from Object. Its methods are
+    //        out_string(Str) : SELF_TYPE       writes a string to the output
+    //        out_int(Int) : SELF_TYPE            "    an int    "  "     "
+    //        in_string() : Str                 reads a string from the input
+    //        in_int() : Int                      "   an int     "  "     "
+    //
+    Class_ IO_class = 
+	class_(IO, 
+	       Object,
+	       append_Features(
+			       append_Features(
+					       append_Features(
+							       single_Features(method(out_string, single_Formals(formal(arg, Str)),
+										      SELF_TYPE, no_expr())),
+							       single_Features(method(out_int, single_Formals(formal(arg, Int)),
+										      SELF_TYPE, no_expr()))),
+					       single_Features(method(in_string, nil_Formals(), Str, no_expr()))),
+			       single_Features(method(in_int, nil_Formals(), Int, no_expr()))),
+	       filename);  
+
+    //
+    // The Int class has no methods and only a single attribute, the
+    // "val" for the integer. 
+    //
+    Class_ Int_class =
+	class_(Int, 
+	       Object,
+	       single_Features(attr(val, prim_slot, no_expr())),
+	       filename);
+
+    //
+    // Bool also has only the "val" slot.
+    //
+    Class_ Bool_class =
+	class_(Bool, Object, single_Features(attr(val, prim_slot, no_expr())),filename);
+
+    //
+    // The class Str has a number of slots and operations:
+    //       val                                  the length of the string
+    //       str_field                            the string itself
+    //       length() : Int                       returns length of the string
+    //       concat(arg: Str) : Str               performs string concatenation
+    //       substr(arg: Int, arg2: Int): Str     substring selection
+    //       
+    Class_ Str_class =
+	class_(Str, 
+	       Object,
+	       append_Features(
+			       append_Features(
+					       append_Features(
+							       append_Features(
+									       single_Features(attr(val, Int, no_expr())),
+									       single_Features(attr(str_field, prim_slot, no_expr()))),
+							       single_Features(method(length, nil_Formals(), Int, no_expr()))),
+					       single_Features(method(concat, 
+								      single_Formals(formal(arg, Str)),
+								      Str, 
+								      no_expr()))),
+			       single_Features(method(substr, 
+						      append_Formals(single_Formals(formal(arg, Int)), 
+								     single_Formals(formal(arg2, Int))),
+						      Str, 
+						      no_expr()))),
+	       filename);
+
+    classes_ = append_Classes(nil_Classes(), single_Classes(Object_class));
+    classes_ = append_Classes(classes_, single_Classes(IO_class));
+    classes_ = append_Classes(classes_, single_Classes(Int_class));
+    classes_ = append_Classes(classes_, single_Classes(Bool_class));
+    classes_ = append_Classes(classes_, single_Classes(Str_class));
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// Interface files
+//
+// An interface file (.cli) describes classes without their bodies:
+// the name, parent, attribute types and method signatures of each.
+// semant loads the files listed in COOL_SEMANT_INTERFACES (separated
+// by ':') and installs their classes next to the basic ones, so a
+// program can be checked against a class library without parsing the
+// library's source. COOL_SEMANT_INTERFACE_OUT asks for an interface
+// file describing the classes of a program that checked cleanly.
+//
+// Layout, every integer a native uint32:
+//
+//    "COOLCLI" 0  version  nstrings  { length bytes }...
+//    nclasses  { name parent nattrs { name type }...
+//                nmethods { name return_type nformals { name type }... }... }...
+//
+// All names are indices into the string list.
+//
+///////////////////////////////////////////////////////////////////
+
+static const char CLI_MAGIC[8] = { 'C', 'O', 'O', 'L', 'C', 'L', 'I', 0 };
+static const uint32_t CLI_VERSION = 1;
+
+struct CliReader {
+    const std::string& buf;
+    size_t pos;
+    bool ok;
+    std::vector<Symbol> strings;
+
+    CliReader(const std::string& b) : buf(b), pos(0), ok(true) { }
+
+    uint32_t u32()
+    {
+        uint32_t v = 0;
+
+        if (!ok || buf.size() - pos < sizeof(v))
+            ok = false;
+        else
+        {
+            memcpy(&v, buf.data() + pos, sizeof(v));
+            pos += sizeof(v);
+        }
+
+        return v;
+    }
+
+    Symbol name()
+    {
+        uint32_t i = u32();
+
+        if (i >= strings.size())
+        {
+            ok = false;
+            return No_type;
+        }
+
+        return strings[i];
+    }
+};
+
+struct CliWriter {
+    std::string body;
+    std::vector<Symbol> strings;
+    std::unordered_map<Symbol, uint32_t> index;
+
+    void u32(uint32_t v) { body.append((const char *) &v, sizeof(v)); }
+
+    void name(Symbol s)
+    {
+        std::unordered_map<Symbol, uint32_t>::const_iterator it = index.find(s);
+
+        if (it == index.end())
+        {
+            it = index.insert(std::make_pair(s, (uint32_t) strings.size())).first;
+            strings.push_back(s);
+        }
+
+        u32(it->second);
+    }
+};
+
+void ClassTable::install_interface_classes()
+{
+    interfaces_ = nil_Classes();
+
+    const char *paths = getenv("COOL_SEMANT_INTERFACES");
+    if (paths == NULL)
+        return;
+
+    std::string list(paths);
+    size_t start = 0;
+
+    while (start <= list.size())
+    {
+        size_t end = list.find(':', start);
+        if (end == std::string::npos)
+            end = list.size();
+
+        std::string path = list.substr(start, end - start);
+        if (!path.empty() && !read_interface(path.c_str()))
+            semant_error() << "Could not read interface file " << path << "." << std::endl;
+
+        start = end + 1;
+    }
+}
+
+/*
+ * Builds bodyless classes, like the basic ones, from an interface
+ * file. Nothing is installed unless the whole file reads cleanly.
+ */
+bool ClassTable::read_interface(const char *path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
+
+    std::string buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    if (buf.size() < sizeof(CLI_MAGIC) || memcmp(buf.data(), CLI_MAGIC, sizeof(CLI_MAGIC)) != 0)
+        return false;
+
+    CliReader r(buf);
+    r.pos = sizeof(CLI_MAGIC);
+
+    if (r.u32() != CLI_VERSION)
+        return false;
+
+    uint32_t nstrings = r.u32();
+    for (uint32_t i = 0; i < nstrings && r.ok; i++)
+    {
+        uint32_t len = r.u32();
+
+        if (!r.ok || buf.size() - r.pos < len)
+            return false;
+
+        r.strings.push_back(idtable.add_string((char *) buf.substr(r.pos, len).c_str()));
+        r.pos += len;
+    }
+
+    Symbol filename = stringtable.add_string((char *) path);
+    Classes loaded = nil_Classes();
+    uint32_t nclasses = r.u32();
+
+    for (uint32_t i = 0; i < nclasses && r.ok; i++)
+    {
+        Symbol name = r.name();
+        Symbol parent = r.name();
+        Features features = nil_Features();
+
+        uint32_t nattrs = r.u32();
+        for (uint32_t j = 0; j < nattrs && r.ok; j++)
+        {
+            Symbol attr_name = r.name();
+            Symbol type = r.name();
+            features = append_Features(features, single_Features(attr(attr_name, type, no_expr())));
+        }
+
+        uint32_t nmethods = r.u32();
+        for (uint32_t j = 0; j < nmethods && r.ok; j++)
+        {
+            Symbol method_name = r.name();
+            Symbol return_type = r.name();
+            Formals formals = nil_Formals();
+
+            uint32_t nformals = r.u32();
+            for (uint32_t k = 0; k < nformals && r.ok; k++)
+            {
+                Symbol formal_name = r.name();
+                Symbol type = r.name();
+                formals = append_Formals(formals, single_Formals(formal(formal_name, type)));
+            }
+
+            features = append_Features(features, 
+                                       single_Features(method(method_name, formals, return_type, no_expr())));
+        }
+
+        loaded = append_Classes(loaded, single_Classes(class_(name, parent, features, filename)));
+    }
+
+    if (!r.ok)
+        return false;
+
+    interfaces_ = append_Classes(interfaces_, loaded);
+    return true;
+}
+
+bool ClassTable::write_interface(const char *path, Classes classes)
+{
+    CliWriter w;
+
+    w.u32(classes->len());
+
+    for (int i = classes->first(); classes->more(i); i = classes->next(i))
+    {
+        Class_ c = classes->nth(i);
+        Features features = c->get_features();
+        std::vector<attr_class*> attrs;
+        std::vector<method_class*> methods;
+
+        for (int j = features->first(); features->more(j); j = features->next(j))
+        {
+            attr_class *a = dynamic_cast<attr_class*>(features->nth(j));
+            method_class *m = dynamic_cast<method_class*>(features->nth(j));
+            count(&SemantStats::casts, 2);
+
+            if (a != NULL)
+                attrs.push_back(a);
+            if (m != NULL)
+                methods.push_back(m);
+        }
+
+        w.name(c->get_name());
+        w.name(c->get_parent());
+
+        w.u32(attrs.size());
+        for (size_t j = 0; j < attrs.size(); j++)
+        {
+            w.name(attrs[j]->get_name());
+            w.name(attrs[j]->get_type_decl());
+        }
+
+        w.u32(methods.size());
+        for (size_t j = 0; j < methods.size(); j++)
+        {
+            Formals formals = methods[j]->get_formals();
+
+            w.name(methods[j]->get_name());
+            w.name(methods[j]->get_return_type());
+            w.u32(formals->len());
+
+            for (int k = formals->first(); formals->more(k); k = formals->next(k))
+            {
+                w.name(formals->nth(k)->get_name());
+                w.name(formals->nth(k)->get_type());
+            }
+        }
+    }
+
+    std::string header(CLI_MAGIC, sizeof(CLI_MAGIC));
+    CliWriter strings;
+
+    strings.u32(CLI_VERSION);
+    strings.u32(w.strings.size());
+    for (size_t i = 0; i < w.strings.size(); i++)
+    {
+        strings.u32(w.strings[i]->get_len());
+        strings.body.append(w.strings[i]->get_string(), w.strings[i]->get_len());
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << header << strings.body << w.body;
+    out.close();
+
+    return out.good();
+}
+
+////////////////////////////////////////////////////////////////////
+//
+// semant_error is an overloaded function for reporting errors
+// during semantic analysis.  There are three versions:
+//
+//    ostream& ClassTable::semant_error()                
+//
+//    ostream& ClassTable::semant_error(Class_ c)
+//       print line number and filename for `c'
+//
+//    ostream& ClassTable::semant_error(Symbol filename, tree_node *t)  
+//       print a line number and filename
+//
+///////////////////////////////////////////////////////////////////
+
+ostream& ClassTable::semant_error(Class_ c)
+{                                                             
+    return semant_error(c->get_filename(),c);
+}    
+
+ostream& ClassTable::semant_error(Symbol filename, tree_node *t)
+{
+    *state().out << filename << ":" << t->get_line_number() << ": ";
+    return semant_error();
+}
+
+ostream& ClassTable::semant_error()                  
+{                                                 
+    state().errors++;                            
+    return *state().out;
+} 
+
+/*
+ * Names every check can see: true, false and the class names.
+ */
+void ClassTable::enter_globals(ScopedTable<Symbol, Entry>& symbols, const std::vector<Class_>& all)
+{
+    symbols.enterscope();
+
+    symbols.addid(True, Bool);
+    symbols.addid(False, Bool);
+
+    for (size_t i = 0; i < all.size(); i++)
+    {
+        Symbol name = all[i]->get_name();
+        symbols.addid(name, name);
+    }
+}
+
+/*
+ * Checks classes from jobs, pulling the next index from a shared
+ * counter. Each class writes its diagnostics to its own buffer so the
+ * caller can print them in source order, whatever the interleaving.
+ */
+void ClassTable::check_worker(std::vector<ClassCheck>& jobs, const std::vector<Class_>& all, 
+                              std::atomic<int>& next)
+{
+    CheckState st(NULL);
+
+    enter_globals(st.symbols, all);
+    local_state_ = &st;
+
+    for (int i = next++; i < (int) jobs.size(); i = next++)
+    {
+        ClassCheck &job = jobs[i];
+
+        st.out = &job.out;
+        st.errors = 0;
+        st.deps = job.track_deps ? &job.deps : NULL;
+
+        st.stats = SemantStats();
+        st.symbols.reset_stats();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        set_current_class(job.c);
+        job.c->semant(this);
+
+        job.errors = st.errors;
+        job.stats = st.stats;
+        job.stats.scopes = st.symbols.scopes_entered();
+        job.stats.peak_bindings = st.symbols.peak_bindings();
+        job.stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    local_state_ = NULL;
+}
+
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+static uint64_t fnv1a(const std::string& s, uint64_t h = FNV_OFFSET)
+{
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        h ^= (unsigned char) s[i];
+        h *= FNV_PRIME;
+    }
+
+    return h;
+}
+
+/*
+ * Hash of the whole tree of a class, line numbers included, since
+ * those end up in the diagnostics.
+ */
+static uint64_t body_hash(Class_ c)
+{
+    std::ostringstream s;
+    c->dump(s, 0);
+    return fnv1a(s.str());
+}
+
+/*
+ * What other classes can see of c: its parent, attribute types and
+ * method signatures.
+ */
+static std::string signature(Class_ c, unsigned long& casts)
+{
+    std::ostringstream s;
+    Features features = c->get_features();
+
+    s << c->get_name() << " " << c->get_parent() << "\n";
+
+    for (int i = features->first(); features->more(i); i = features->next(i))
+    {
+        attr_class *attr = dynamic_cast<attr_class*>(features->nth(i));
+        method_class *method = dynamic_cast<method_class*>(features->nth(i));
+        casts += 2;
+
+        if (attr != NULL)
+            s << "attr " << attr->get_name() << " " << attr->get_type_decl() << "\n";
+
+        if (method != NULL)
+        {
+            Formals formals = method->get_formals();
+
+            s << "method " << method->get_name();
+            for (int j = formals->first(); formals->more(j); j = formals->next(j))
+                s << " " << formals->nth(j)->get_type();
+            s << " " << method->get_return_type() << "\n";
+        }
+    }
+
+    return s.str();
+}
+
+static void walk_class(Class_ c, std::vector<Expression>& nodes)
+{
+    Features features = c->get_features();
+    for (int i = features->first(); features->more(i); i = features->next(i))
+        features->nth(i)->walk(nodes);
+}
+
+/*
+ * Effective signature hash of every class: its own signature folded
+ * into its parent's effective hash, so a change anywhere up the chain
+ * shows up in every class below it.
+ */
+std::vector<uint64_t> ClassTable::signature_hashes()
+{
+    std::vector<uint64_t> hashes(classes_by_id_.size(), 0);
+    std::vector<bool> done(classes_by_id_.size(), false);
+    std::vector<TypeId> chain;
+
+    for (TypeId t = FIRST_CLASS_ID; t < classes_by_id_.size(); t++)
+    {
+        chain.clear();
+
+        TypeId u = t;
+        while (!done[u])
+        {
+            chain.push_back(u);
+            if (class_nodes_[u].up.empty())
+                break;
+            u = class_nodes_[u].up[0];
+        }
+
+        for (size_t i = chain.size(); i-- > 0; )
+        {
+            const ClassNode &node = class_nodes_[chain[i]];
+            uint64_t seed = node.up.empty() ? FNV_OFFSET : hashes[node.up[0]];
+
+            hashes[chain[i]] = fnv1a(signature(classes_by_id_[chain[i]], state().stats.casts), seed);
+            done[chain[i]] = true;
+        }
+    }
+
+    return hashes;
+}
+
+/*
+ * Puts back the types an earlier run gave c's expressions, provided
+ * the cache has a clean record for c's exact tree and every class that
+ * check looked up still has the same signature. Returns false if c has
+ * to be checked again; otherwise record is the reused entry.
+ */
+bool ClassTable::replay(Class_ c, uint64_t body_hash, SemantCache& cache, 
+                        const std::vector<uint64_t>& signatures, ClassRecord& record)
+{
+    if (!cache.find(body_hash, record) || record.had_errors)
+        return false;
+
+    for (size_t i = 0; i < record.deps.size(); i++)
+    {
+        TypeId t = get_type_id(record.deps[i]);
+        uint64_t now = is_class_id(t) ? signatures[t] : 0;
+
+        if (record.dep_signatures[i] != now)
+            return false;
+    }
+
+    std::vector<Expression> nodes;
+    walk_class(c, nodes);
+
+    if (nodes.size() != record.types.size())
+        return false;
+
+    for (size_t i = 0; i < nodes.size(); i++)
+        nodes[i]->set_type(record.types[i]);
+
+    return true;
+}
+
+static const char CACHE_MAGIC[8] = { 'C', 'O', 'O', 'L', 'S', 'E', 'M', 0 };
+static const uint32_t CACHE_VERSION = 1;
+static const uint32_t NO_STRING = (uint32_t) -1;
+
+/*
+ * Maps the cache file. Only the header is checked here; records are
+ * checked against the file size as they are read, so a truncated or
+ * stale file costs a miss, not a crash.
+ */
+bool SemantCache::open(const char *path)
+{
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t) st.st_size < sizeof(CacheHeader))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (p == MAP_FAILED)
+        return false;
+
+    base = (char *) p;
+    size = st.st_size;
+    header = (const CacheHeader *) base;
+
+    if (memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 
+            || header->version != CACHE_VERSION
+            || !in_bounds(header->strings, (uint64_t) header->nstrings * sizeof(uint32_t))
+            || !in_bounds(header->records, (uint64_t) header->nrecords * sizeof(CacheRecord)))
+    {
+        close();
+        return false;
+    }
+
+    symbols.assign(header->nstrings, (Symbol) NULL);
+    return true;
+}
+
+void SemantCache::close()
+{
+    if (base != NULL)
+        munmap(base, size);
+
+    base = NULL;
+    size = 0;
+    header = NULL;
+    symbols.clear();
+}
+
+/*
+ * Binary search for body_hash, then copy the record out, interning
+ * the names it refers to on first use.
+ */
+bool SemantCache::find(uint64_t body_hash, ClassRecord& record)
+{
+    if (header == NULL)
+        return false;
+
+    const CacheRecord *records = (const CacheRecord *) (base + header->records);
+    uint32_t lo = 0, hi = header->nrecords;
+
+    while (lo < hi)
+    {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (records[mid].body_hash < body_hash)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if (lo == header->nrecords || records[lo].body_hash != body_hash)
+        return false;
+
+    const CacheRecord &r = records[lo];
+    uint64_t bytes = (uint64_t) r.ndeps * (sizeof(uint64_t) + sizeof(uint32_t)) 
+        + (uint64_t) r.ntypes * sizeof(uint32_t);
+
+    if (!in_bounds(r.data, bytes))
+        return false;
+
+    const uint64_t *dep_signatures = (const uint64_t *) (base + r.data);
+    const uint32_t *deps = (const uint32_t *) (dep_signatures + r.ndeps);
+    const uint32_t *types = deps + r.ndeps;
+    const uint32_t *offsets = (const uint32_t *) (base + header->strings);
+
+    std::vector<uint32_t> names(deps, deps + r.ndeps);
+    names.insert(names.end(), types, types + r.ntypes);
+
+    std::vector<Symbol> resolved(names.size(), (Symbol) NULL);
+
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        uint32_t n = names[i];
+
+        if (n == NO_STRING)
+            continue;
+
+        if (n >= header->nstrings || offsets[n] >= size 
+                || memchr(base + offsets[n], 0, size - offsets[n]) == NULL)
+            return false;
+
+        if (symbols[n] == NULL)
+            symbols[n] = idtable.add_string(base + offsets[n]);
+
+        resolved[i] = symbols[n];
+    }
+
+    record.body_hash = r.body_hash;
+    record.had_errors = (r.had_errors != 0);
+    record.dep_signatures.assign(dep_signatures, dep_signatures + r.ndeps);
+    record.deps.assign(resolved.begin(), resolved.begin() + r.ndeps);
+    record.types.assign(resolved.begin() + r.ndeps, resolved.end());
+
+    return true;
+}
+
+static uint32_t string_index(Symbol name, std::unordered_map<Symbol, uint32_t>& index, 
+                             std::vector<Symbol>& strings)
+{
+    if (name == NULL)
+        return NO_STRING;
+
+    std::unordered_map<Symbol, uint32_t>::const_iterator it = index.find(name);
+    if (it != index.end())
+        return it->second;
+
+    index[name] = strings.size();
+    strings.push_back(name);
+    return strings.size() - 1;
+}
+
+template <class T>
+static void append(std::string& buf, const T& value)
+{
+    buf.append((const char *) &value, sizeof(T));
+}
+
+static void pad8(std::string& buf)
+{
+    while (buf.size() % 8 != 0)
+        buf.push_back('\0');
+}
+
+static bool record_less(const ClassRecord *a, const ClassRecord *b)
+{
+    return a->body_hash < b->body_hash;
+}
+
+/*
+ * Lays the whole file out in memory and writes it to a temporary file
+ * that is renamed over path, so a reader never maps half a cache. The
+ * temporary file gets a unique name in path's directory, so compilers
+ * writing the same cache at once don't write into each other's file.
+ */
+bool SemantCache::write(const char *path, const std::vector<ClassRecord>& records)
+{
+    std::vector<const ClassRecord *> sorted;
+    for (size_t i = 0; i < records.size(); i++)
+        sorted.push_back(&records[i]);
+    std::sort(sorted.begin(), sorted.end(), record_less);
+
+    std::unordered_map<Symbol, uint32_t> index;
+    std::vector<Symbol> strings;
+    std::vector<CacheRecord> table(sorted.size());
+    std::string data;
+
+    uint64_t data_start = sizeof(CacheHeader) + sorted.size() * sizeof(CacheRecord);
+
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        const ClassRecord &r = *sorted[i];
+
+        memset(&table[i], 0, sizeof(CacheRecord));
+        table[i].body_hash = r.body_hash;
+        table[i].had_errors = r.had_errors;
+        table[i].ndeps = r.deps.size();
+        table[i].ntypes = r.types.size();
+        table[i].data = data_start + data.size();
+
+        for (size_t k = 0; k < r.deps.size(); k++)
+            append(data, r.dep_signatures[k]);
+        for (size_t k = 0; k < r.deps.size(); k++)
+            append(data, string_index(r.deps[k], index, strings));
+        for (size_t k = 0; k < r.types.size(); k++)
+            append(data, string_index(r.types[k], index, strings));
+
+        pad8(data);
+    }
+
+    CacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.nstrings = strings.size();
+    header.nrecords = sorted.size();
+    header.records = sizeof(CacheHeader);
+    header.strings = data_start + data.size();
+
+    uint64_t chars = header.strings + strings.size() * sizeof(uint32_t);
+    std::string text;
+
+    for (size_t i = 0; i < strings.size(); i++)
+    {
+        append(data, (uint32_t) (chars + text.size()));
+        text.append(strings[i]->get_string(), strings[i]->get_len());
+        text.push_back('\0');
+    }
+
+    std::string tmp = std::string(path) + ".XXXXXX";
+    int fd = mkstemp(&tmp[0]);
+    if (fd < 0)
+        return false;
+
+    FILE *out = fdopen(fd, "wb");
+    if (out == NULL)
+    {
+        ::close(fd);
+        unlink(tmp.c_str());
+        return false;
+    }
+
+    fchmod(fd, 0644);
+    fwrite(&header, sizeof(header), 1, out);
+    if (!table.empty())
+        fwrite(&table[0], sizeof(CacheRecord), table.size(), out);
+    fwrite(data.data(), 1, data.size(), out);
+    fwrite(text.data(), 1, text.size(), out);
+
+    bool ok = !ferror(out);
+    if (fclose(out) != 0)
+        ok = false;
+
+    if (!ok || rename(tmp.c_str(), path) != 0)
+    {
+        unlink(tmp.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Type checks the user classes on a pool of threads. The class graph,
+ * method tables and attribute environments are read-only by now and
+ * each thread has its own CheckState, so the classes are independent.
+ * Diagnostics come out in the same order as a sequential check.
+ *
+ * If COOL_SEMANT_STATE names a file, it is used as a type-check cache:
+ * only classes that changed, failed last time or depend on a class
+ * whose signature changed are checked; the rest get their types back
+ * from the cache, which is then rewritten for the current program.
+ */
+void ClassTable::check_classes(Classes classes)
+{
+    std::vector<Class_> all;
+    for (int i = classes->first(); classes->more(i); i = classes->next(i))
+        all.push_back(classes->nth(i));
+
+    const char *state_path = getenv("COOL_SEMANT_STATE");
+    SemantCache cache;
+    std::vector<uint64_t> signatures;
+    std::vector<ClassRecord> records(all.size());
+    std::vector<bool> dirty(all.size(), true);
+    std::vector<uint64_t> body_hashes;
+
+    if (state_path != NULL)
+    {
+        begin_phase();
+        cache.open(state_path);
+        signatures = signature_hashes();
+
+        // Each hash dumps the whole class, so it is kept for the write.
+        body_hashes.resize(all.size());
+        for (size_t i = 0; i < all.size(); i++)
+        {
+            body_hashes[i] = body_hash(all[i]);
+            dirty[i] = !replay(all[i], body_hashes[i], cache, signatures, records[i]);
+        }
+
+        cache.close();
+        end_phase("cache read");
+    }
+
+    begin_phase();
+
+    std::vector<ClassCheck> jobs(std::count(dirty.begin(), dirty.end(), true));
+    for (size_t i = 0, j = 0; i < all.size(); i++)
+    {
+        if (!dirty[i])
+            continue;
+
+        jobs[j].c = all[i];
+        jobs[j].track_deps = (state_path != NULL);
+        j++;
+    }
+
+    int nthreads = std::thread::hardware_concurrency();
+    if (nthreads > (int) jobs.size())
+        nthreads = jobs.size();
+    if (nthreads < 1)
+        nthreads = 1;
+
+    std::vector<std::thread> pool;
+    std::atomic<int> next(0);
+
+    for (int t = 1; t < nthreads; t++)
+        pool.push_back(std::thread(&ClassTable::check_worker, this, 
+                                   std::ref(jobs), std::cref(all), std::ref(next)));
+
+    check_worker(jobs, all, next);
+
+    for (size_t t = 0; t < pool.size(); t++)
+        pool[t].join();
+
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        error_stream << jobs[i].out.str();
+        main_state_.errors += jobs[i].errors;
+        main_state_.stats.add(jobs[i].stats);
+        class_stats_.push_back(std::make_pair(jobs[i].c->get_name(), jobs[i].stats));
+    }
+
+    end_phase("check");
+
+    if (state_path == NULL)
+        return;
+
+    begin_phase();
+
+    for (size_t i = 0, j = 0; i < all.size(); i++)
+    {
+        if (!dirty[i])
+            continue;
+
+        ClassCheck &job = jobs[j++];
+        ClassRecord &record = records[i];
 
-    // The tree package uses these globals to annotate the classes built below.
-   // curr_lineno  = 0;
-    Symbol filename = stringtable.add_string("<basic class>");
-    
-    // The following demonstrates how to create dummy parse trees to
-    // refer to basic Cool classes.  There's no need for method
-    // bodies -- these are already built into the runtime system.
-    
-    // IMPORTANT: The results of the following expressions are
-    // stored in local variables.  You will want to do something
-    // with those variables at the end of this method to make this
-    // code meaningful.
+        record.body_hash = body_hashes[i];
+        record.had_errors = (job.errors != 0);
 
-    // 
-    // The Object class has no parent class. Its methods are
-    //        abort() : Object    aborts the program
-    //        type_name() : Str   returns a string representation of class name
-    //        copy() : SELF_TYPE  returns a copy of the object
-    //
-    // There is no need for method bodies in the basic classes---these
-    // are already built in to the runtime system.
+        record.deps.swap(job.deps.others);
+        for (TypeId t = 0; t < job.deps.types.size(); t++)
+            if (job.deps.types[t])
+                record.deps.push_back(type_names_[t]);
+        record.deps.push_back(all[i]->get_name());
+        std::sort(record.deps.begin(), record.deps.end());
+        record.deps.erase(std::unique(record.deps.begin(), record.deps.end()), record.deps.end());
 
-    Class_ Object_class =
-	class_(Object, 
-	       No_class,
-	       append_Features(
-			       append_Features(
-					       single_Features(method(cool_abort, nil_Formals(), Object, no_expr())),
-					       single_Features(method(type_name, nil_Formals(), Str, no_expr()))),
-			       single_Features(method(copy, nil_Formals(), SELF_TYPE, no_expr()))),
-	       filename);
+        record.dep_signatures.clear();
+        for (size_t k = 0; k < record.deps.size(); k++)
+        {
+            TypeId t = get_type_id(record.deps[k]);
+            record.dep_signatures.push_back(is_class_id(t) ? signatures[t] : 0);
+        }
 
-    // 
-    // The IO class inherits from Object. Its methods are
-    //        out_string(Str) : SELF_TYPE       writes a string to the output
-    //        out_int(Int) : SELF_TYPE            "    an int    "  "     "
-    //        in_string() : Str                 reads a string from the input
-    //        in_int() : Int                      "   an int     "  "     "
-    //
-    Class_ IO_class = 
-	class_(IO, 
-	       Object,
-	       append_Features(
-			       append_Features(
-					       append_Features(
-							       single_Features(method(out_string, single_Formals(formal(arg, Str)),
-										      SELF_TYPE, no_expr())),
-							       single_Features(method(out_int, single_Formals(formal(arg, Int)),
-										      SELF_TYPE, no_expr()))),
-					       single_Features(method(in_string, nil_Formals(), Str, no_expr()))),
-			       single_Features(method(in_int, nil_Formals(), Int, no_expr()))),
-	       filename);  
+        std::vector<Expression> nodes;
+        walk_class(all[i], nodes);
 
-    //
-    // The Int class has no methods and only a single attribute, the
-    // "val" for the integer. 
-    //
-    Class_ Int_class =
-	class_(Int, 
-	       Object,
-	       single_Features(attr(val, prim_slot, no_expr())),
-	       filename);
+        record.types.clear();
+        for (size_t k = 0; k < nodes.size(); k++)
+            record.types.push_back(nodes[k]->get_type());
+    }
 
-    //
-    // Bool also has only the "val" slot.
-    //
-    Class_ Bool_class =
-	class_(Bool, Object, single_Features(attr(val, prim_slot, no_expr())),filename);
+    SemantCache::write(state_path, records);
+    end_phase("cache write");
+}
 
-    //
-    // The class Str has a number of slots and operations:
-    //       val                                  the length of the string
-    //       str_field                            the string itself
-    //       length() : Int                       returns length of the string
-    //       concat(arg: Str) : Str               performs string concatenation
-    //       substr(arg: Int, arg2: Int): Str     substring selection
-    //       
-    Class_ Str_class =
-	class_(Str, 
-	       Object,
-	       append_Features(
-			       append_Features(
-					       append_Features(
-							       append_Features(
-									       single_Features(attr(val, Int, no_expr())),
-									       single_Features(attr(str_field, prim_slot, no_expr()))),
-							       single_Features(method(length, nil_Formals(), Int, no_expr()))),
-					       single_Features(method(concat, 
-								      single_Formals(formal(arg, Str)),
-								      Str, 
-								      no_expr()))),
-			       single_Features(method(substr, 
-						      append_Formals(single_Formals(formal(arg, Int)), 
-								     single_Formals(formal(arg2, Int))),
-						      Str, 
-						      no_expr()))),
-	       filename);
+void SemantStats::add(const SemantStats& s)
+{
+    get_class += s.get_class;
+    get_method += s.get_method;
+    conforms += s.conforms;
+    lub += s.lub;
+    casts += s.casts;
+    scopes += s.scopes;
+    peak_bindings = std::max(peak_bindings, s.peak_bindings);
+    seconds += s.seconds;
+}
 
-    classes_ = append_Classes(nil_Classes(), single_Classes(Object_class));
-    classes_ = append_Classes(classes_, single_Classes(IO_class));
-    classes_ = append_Classes(classes_, single_Classes(Int_class));
-    classes_ = append_Classes(classes_, single_Classes(Bool_class));
-    classes_ = append_Classes(classes_, single_Classes(Str_class));
+/*
+ * A phase covers everything the main thread counts between
+ * begin_phase and end_phase, plus whatever worker stats are added to
+ * main_state_ in between. The first phase starts with the ClassTable.
+ */
+void ClassTable::begin_phase()
+{
+    main_state_.stats = SemantStats();
+    main_state_.symbols.reset_stats();
+    phase_clock_ = std::chrono::steady_clock::now();
 }
 
-////////////////////////////////////////////////////////////////////
-//
-// semant_error is an overloaded function for reporting errors
-// during semantic analysis.  There are three versions:
-//
-//    ostream& ClassTable::semant_error()                
-//
-//    ostream& ClassTable::semant_error(Class_ c)
-//       print line number and filename for `c'
-//
-//    ostream& ClassTable::semant_error(Symbol filename, tree_node *t)  
-//       print a line number and filename
-//
-///////////////////////////////////////////////////////////////////
+void ClassTable::end_phase(const char *name)
+{
+    SemantStats s = main_state_.stats;
 
-ostream& ClassTable::semant_error(Class_ c)
-{                                                             
-    return semant_error(c->get_filename(),c);
-}    
+    s.scopes += main_state_.symbols.scopes_entered();
+    s.peak_bindings = std::max(s.peak_bindings, (unsigned long) main_state_.symbols.peak_bindings());
+    s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - phase_clock_).count();
 
-ostream& ClassTable::semant_error(Symbol filename, tree_node *t)
+    phase_stats_.push_back(std::make_pair(name, s));
+}
+
+static void print_stats_row(ostream& out, const char *name, const SemantStats& s)
 {
-    error_stream << filename << ":" << t->get_line_number() << ": ";
-    return semant_error();
+    out << "  " << std::left << std::setw(20) << name << std::right
+        << std::fixed << std::setprecision(6) << std::setw(10) << s.seconds
+        << std::setw(11) << s.get_class
+        << std::setw(11) << s.get_method
+        << std::setw(11) << s.conforms
+        << std::setw(11) << s.lub
+        << std::setw(11) << s.casts
+        << std::setw(11) << s.scopes
+        << std::setw(11) << s.peak_bindings << std::endl;
 }
 
-ostream& ClassTable::semant_error()                  
-{                                                 
-    semant_errors++;                            
-    return error_stream;
-} 
+/*
+ * The report asked for with COOL_SEMANT_STATS. Class seconds are the
+ * time of one worker thread, so they can add up to more than the check
+ * phase; classes taken from the type-check cache are not listed.
+ */
+void ClassTable::print_stats(ostream& out)
+{
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+
+    out << "  " << std::left << std::setw(20) << "semant stats" << std::right
+        << std::setw(10) << "seconds"
+        << std::setw(11) << "get_class"
+        << std::setw(11) << "get_method"
+        << std::setw(11) << "conforms"
+        << std::setw(11) << "lub"
+        << std::setw(11) << "casts"
+        << std::setw(11) << "scopes"
+        << std::setw(11) << "peak" << std::endl;
+
+    SemantStats total;
+    for (size_t i = 0; i < phase_stats_.size(); i++)
+    {
+        print_stats_row(out, phase_stats_[i].first, phase_stats_[i].second);
+        total.add(phase_stats_[i].second);
+    }
+    print_stats_row(out, "total", total);
+
+    if (!class_stats_.empty())
+        out << std::endl;
+
+    for (size_t i = 0; i < class_stats_.size(); i++)
+        print_stats_row(out, class_stats_[i].first->get_string(), class_stats_[i].second);
+
+    out.flags(flags);
+    out.precision(precision);
+}
 
 
 
@@ -488,34 +1635,40 @@ void program_class::semant()
 {
     initialize_constants();
 
+    bool stats = (getenv("COOL_SEMANT_STATS") != NULL);
+
     /* ClassTable constructor may do some semantic analysis */
     ClassTable *classtable = new ClassTable(classes);
+    classtable->end_phase("class table");
 
     if (classtable->errors()) {
+	    if (stats)
+	        classtable->print_stats(cerr);
 	    cerr << "Compilation halted due to static semantic errors." << endl;
 	    exit(1);
     }  
     
-    classtable->symbols_.enterscope();
-
-    classtable->symbols_.addid(True, Bool);
-    classtable->symbols_.addid(False, Bool);
-
     /* some semantic analysis code may go here */
-    for (int i = classes->first(); classes->more(i); i = classes->next(i))
-    {
-        Class_ c = classes->nth(i);
-        Symbol name = c->get_name();
-        classtable->symbols_.addid(name, name);
-        c->semant(classtable);
-    }
-
-    classtable->symbols_.exitscope();
+    classtable->check_classes(classes);
 
     if (classtable->errors()) {
+	if (stats)
+	    classtable->print_stats(cerr);
 	cerr << "Compilation halted due to static semantic errors." << endl;
 	exit(1);
     } 
+
+    const char *interface_path = getenv("COOL_SEMANT_INTERFACE_OUT");
+    if (interface_path != NULL)
+    {
+        classtable->begin_phase();
+        if (!classtable->write_interface(interface_path, classes))
+            cerr << "Could not write interface file " << interface_path << "." << endl;
+        classtable->end_phase("interface");
+    }
+
+    if (stats)
+        classtable->print_stats(cerr);
 }
 
 void class__class::semant(ClassTableP classtable)
@@ -534,20 +1687,20 @@ void class__class::semant(ClassTableP classtable)
         return;
     }
 
-    classtable->symbols_.enterscope();
+    classtable->symbols().enterscope();
     classtable->set_current_class(this);
-    classtable->symbols_.addid(self, classtable->get_current_class()->get_name());
+    classtable->symbols().addid(self, classtable->get_current_class()->get_name());
     classtable->publish_variables(this);
     for (int i = features->first(); features->more(i); i = features->next(i))
     {
         features->nth(i)->semant(classtable);
     }
-    classtable->symbols_.exitscope();
+    classtable->symbols().exitscope();
 }
 
 void method_class::semant(ClassTableP classtable)
 {
-    classtable->symbols_.enterscope();
+    classtable->symbols().enterscope();
     publish(classtable);
 
     Symbol type = expr->semant(classtable);
@@ -565,7 +1718,7 @@ void method_class::semant(ClassTableP classtable)
     }
 
     if (type == SELF_TYPE)
-        type = classtable->symbols_.lookup(self);
+        type = classtable->symbols().lookup(self);
 
     if (classtable->get_class(return_type) == NULL)
     {
@@ -574,7 +1727,7 @@ void method_class::semant(ClassTableP classtable)
         goto exit;
     }
 
-    if (!classtable->is_subclass(classtable->get_class(type), classtable->get_class(return_type)))
+    if (!classtable->conforms(type, return_type))
     {
         classtable->semant_error(classtable->get_current_class()) << 
             "Wrong return type in method " << name << " expected " << return_type 
@@ -609,7 +1762,7 @@ void method_class::semant(ClassTableP classtable)
     }          
 
 exit:
-    classtable->symbols_.exitscope();
+    classtable->symbols().exitscope();
 }
 
 void attr_class::semant(ClassTableP classtable)
@@ -629,7 +1782,7 @@ void attr_class::semant(ClassTableP classtable)
         return;
     }
 
-    if (!classtable->is_subclass(classtable->get_class(type), classtable->get_class(type_decl)))
+    if (!classtable->conforms(type, type_decl))
     {
         classtable->semant_error(classtable->get_current_class()) << 
             "Wrong type in attribute initialization: " << name 
@@ -640,7 +1793,7 @@ void attr_class::semant(ClassTableP classtable)
 
 Symbol assign_class::semant(ClassTableP classtable)
 {
-    Symbol type = classtable->symbols_.lookup(name);
+    Symbol type = classtable->lookup_variable(name);
                               
     if (type == NULL) 
     {
@@ -720,8 +1873,7 @@ Symbol static_dispatch_class::semant(ClassTableP classtable)
     {
         Symbol type = actual->nth(i)->semant(classtable);
         
-        if (!classtable->is_subclass(classtable->get_class(type), 
-                    classtable->get_class(formals->nth(j)->get_type())))
+        if (!classtable->conforms(type, formals->nth(j)->get_type()))
         {
             classtable->semant_error(classtable->get_current_class()) << 
                 name << " parameter " << i << " expected " << formals->nth(j)->get_type()
@@ -788,8 +1940,7 @@ Symbol dispatch_class::semant(ClassTableP classtable)
     {
         Symbol type = actual->nth(i)->semant(classtable);
        
-        if (!classtable->is_subclass(classtable->get_class(type), 
-                    classtable->get_class(formals->nth(j)->get_type())))
+        if (!classtable->conforms(type, formals->nth(j)->get_type()))
         {
             classtable->semant_error(classtable->get_current_class()) << 
                 name << " parameter " << i << " expected " << formals->nth(j)->get_type()
@@ -825,7 +1976,7 @@ Symbol cond_class::semant(ClassTableP classtable)
     Symbol type2 = then_exp->semant(classtable);
     Symbol type3 = else_exp->semant(classtable);
 
-    Symbol type4 = classtable->get_lub(classtable->get_class(type2), classtable->get_class(type3));
+    Symbol type4 = classtable->lub(type2, type3);
 
     set_type(type4);
     return type4;
@@ -849,50 +2000,71 @@ Symbol loop_class::semant(ClassTableP classtable)
     return Object;
 }
 
+/*
+ * Duplicate branches are found with a bitset over type IDs and the lub
+ * is accumulated in the same pass. Only the marks this case set are
+ * cleared afterwards, so the bitset is reused without an O(classes)
+ * reset.
+ */
 Symbol typcase_class::semant(ClassTableP classtable)
 {
-    Symbol type1 = expr->semant(classtable);
-    Symbol type2;
-
-    SymbolTable<Symbol, Entry> distinct_set;
-    distinct_set.enterscope();
+    expr->semant(classtable);
 
-    Symbol lub = NULL;
+    std::vector<bool> &seen = classtable->enter_case();
+    TypeId lub = INVALID_TYPE_ID;
+    bool first = true;
+    int i;
 
-    for (int i = cases->first(); cases->more(i); i = cases->next(i))
+    for (i = cases->first(); cases->more(i); i = cases->next(i))
     {
-        Symbol type_decl = cases->nth(i)->get_type();
-
-        type2 = cases->nth(i)->semant(classtable);
+        TypeId type_decl = classtable->get_type_id(cases->nth(i)->get_type());
+        TypeId type2 = classtable->get_type_id(cases->nth(i)->semant(classtable));
         
-        if (distinct_set.lookup(type_decl) != NULL)
+        if (type_decl != INVALID_TYPE_ID && seen[type_decl])
         {
             classtable->semant_error(classtable->get_current_class()) << 
                 "Branches in Case statement must be of different types" << std::endl; 
-            set_type(Object);
-            return Object;
+            break;
         }
 
-        distinct_set.addid(type_decl, type_decl);
+        if (type_decl != INVALID_TYPE_ID)
+            seen[type_decl] = true;
         
-        if (lub == NULL)
-            lub = type2;
+        lub = first ? type2 : classtable->lub(lub, type2);
+        first = false;
+    }
+
+    bool duplicate = cases->more(i);
+
+    for (int j = cases->first(); j != i; j = cases->next(j))
+    {
+        TypeId type_decl = classtable->get_type_id(cases->nth(j)->get_type());
+        if (type_decl != INVALID_TYPE_ID)
+            seen[type_decl] = false;
+    }
 
-        lub = classtable->get_lub(classtable->get_class(lub), classtable->get_class(type2));
+    classtable->exit_case();
+
+    if (duplicate || lub == INVALID_TYPE_ID)
+    {
+        set_type(Object);
+        return Object;
     }
 
-    set_type(lub);
-    return lub;
+    Symbol result = classtable->get_type_name(lub);
+
+    set_type(result);
+    return result;
 }
  
 Symbol branch_class::semant(ClassTableP classtable)
 {
-    classtable->symbols_.enterscope();
-    classtable->symbols_.addid(name, type_decl);
+    classtable->symbols().enterscope();
+    classtable->symbols().addid(name, type_decl);
 
     Symbol type = expr->semant(classtable);
 
-    classtable->symbols_.exitscope();
+    classtable->symbols().exitscope();
 
     return type;
 }
@@ -929,12 +2101,12 @@ Symbol let_class::semant(ClassTableP classtable)
         return Object; 
     } 
     
-    classtable->symbols_.enterscope();
-    classtable->symbols_.addid(identifier, type_decl);
+    classtable->symbols().enterscope();
+    classtable->symbols().addid(identifier, type_decl);
 
     Symbol type2 = body->semant(classtable);
 
-    classtable->symbols_.exitscope();
+    classtable->symbols().exitscope();
 
     set_type(type2);
     return type2;
@@ -1145,7 +2317,7 @@ Symbol object_class::semant(ClassTableP classtable)
         return SELF_TYPE;
     }
     
-    Symbol type = classtable->symbols_.lookup(name);
+    Symbol type = classtable->lookup_variable(name);
                               
     if (type == NULL) 
     {
@@ -1159,3 +2331,180 @@ Symbol object_class::semant(ClassTableP classtable)
     return type;
 }
 
+/*
+ * walk appends an expression and its subexpressions to nodes in
+ * preorder. The order only depends on the shape of the tree, so the
+ * types of a class's expressions can be saved as a flat list and put
+ * back on an identical tree without type checking it again.
+ */
+void method_class::walk(std::vector<Expression>& nodes)
+{
+    expr->walk(nodes);
+}
+
+void attr_class::walk(std::vector<Expression>& nodes)
+{
+    init->walk(nodes);
+}
+
+void branch_class::walk(std::vector<Expression>& nodes)
+{
+    expr->walk(nodes);
+}
+
+void assign_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    expr->walk(nodes);
+}
+
+void static_dispatch_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    expr->walk(nodes);
+    for (int i = actual->first(); actual->more(i); i = actual->next(i))
+        actual->nth(i)->walk(nodes);
+}
+
+void dispatch_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    expr->walk(nodes);
+    for (int i = actual->first(); actual->more(i); i = actual->next(i))
+        actual->nth(i)->walk(nodes);
+}
+
+void cond_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    pred->walk(nodes);
+    then_exp->walk(nodes);
+    else_exp->walk(nodes);
+}
+
+void loop_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    pred->walk(nodes);
+    body->walk(nodes);
+}
+
+void typcase_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    expr->walk(nodes);
+    for (int i = cases->first(); cases->more(i); i = cases->next(i))
+        cases->nth(i)->walk(nodes);
+}
+
+void block_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    for (int i = body->first(); body->more(i); i = body->next(i))
+        body->nth(i)->walk(nodes);
+}
+
+void let_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    init->walk(nodes);
+    body->walk(nodes);
+}
+
+void plus_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    e1->walk(nodes);
+    e2->walk(nodes);
+}
+
+void sub_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    e1->walk(nodes);
+    e2->walk(nodes);
+}
+
+void mul_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    e1->walk(nodes);
+    e2->walk(nodes);
+}
+
+void divide_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    e1->walk(nodes);
+    e2->walk(nodes);
+}
+
+void neg_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    e1->walk(nodes);
+}
+
+void lt_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    e1->walk(nodes);
+    e2->walk(nodes);
+}
+
+void eq_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    e1->walk(nodes);
+    e2->walk(nodes);
+}
+
+void leq_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    e1->walk(nodes);
+    e2->walk(nodes);
+}
+
+void comp_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    e1->walk(nodes);
+}
+
+void int_const_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+}
+
+void bool_const_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+}
+
+void string_const_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+}
+
+void new__class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+}
+
+void isvoid_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+    e1->walk(nodes);
+}
+
+void no_expr_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+}
+
+void object_class::walk(std::vector<Expression>& nodes)
+{
+    nodes.push_back(this);
+}
+
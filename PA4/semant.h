@@ -2,10 +2,18 @@
 #define SEMANT_H_
 
 #include <assert.h>
+#include <stdint.h>
 #include <iostream>  
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
 #include "cool-tree.h"
 #include "stringtab.h"
-#include "symtab.h"
+#include "scopedtab.h"
 #include "list.h"
 
 #define TRUE 1
@@ -14,6 +22,179 @@
 class ClassTable;
 typedef ClassTable *ClassTableP;
 
+// Dense type IDs. Every class is numbered once the class table is
+// built, after the IDs reserved for SELF_TYPE and No_type, so the
+// per-class tables below are plain arrays indexed by TypeId.
+typedef uint32_t TypeId;
+
+enum {
+  SELF_TYPE_ID = 0,
+  NO_TYPE_ID = 1,
+  FIRST_CLASS_ID = 2
+};
+
+const TypeId INVALID_TYPE_ID = (TypeId) -1;
+
+typedef std::unordered_map<Symbol, TypeId> TypeIds;
+
+// Position of a class in the inheritance tree. enter/exit are DFS
+// times, so c1 <= c2 iff c2's interval encloses c1's. up[k] is the
+// 2^k-th ancestor, used to find least upper bounds by binary lifting.
+struct ClassNode {
+  int enter;
+  int exit;
+  int depth;
+  std::vector<TypeId> up;
+};
+
+// All methods visible in a class, inherited ones included, by name.
+typedef std::unordered_map<Symbol, method_class*> MethodTable;
+
+// Attributes visible in a class. attrs holds the class's own ones, for
+// reporting clashes; visible adds the inherited ones, as method tables
+// do, so a lookup is one probe however deep the class is.
+struct AttrEnv {
+  const AttrEnv *parent;
+  std::unordered_map<Symbol, attr_class*> attrs;
+  std::unordered_map<Symbol, attr_class*> visible;
+
+  attr_class* lookup(Symbol name) const;
+};
+
+// Query counters for the COOL_SEMANT_STATS report. conforms includes
+// is_subclass; casts are the dynamic_casts made walking feature lists;
+// scopes and peak_bindings are taken from the symbols() table.
+struct SemantStats {
+  unsigned long get_class;
+  unsigned long get_method;
+  unsigned long conforms;
+  unsigned long lub;
+  unsigned long casts;
+  unsigned long scopes;
+  unsigned long peak_bindings;
+  double seconds;
+
+  SemantStats() : get_class(0), get_method(0), conforms(0), lub(0), casts(0),
+    scopes(0), peak_bindings(0), seconds(0) { }
+
+  void add(const SemantStats& s);
+};
+
+// The type names a check looked up, each recorded once however often it
+// is looked up: classes as a bitset over type IDs, and the few names
+// that aren't types in a list.
+struct DepSet {
+  std::vector<bool> types;
+  std::vector<Symbol> others;
+
+  void add(Symbol name, TypeId t)
+  {
+    if (t != INVALID_TYPE_ID) {
+      if (t >= types.size())
+        types.resize(t + 1, false);
+      types[t] = true;
+    } else if (std::find(others.begin(), others.end(), name) == others.end())
+      others.push_back(name);
+  }
+};
+
+// Mutable state of one type-checking thread. Everything else in the
+// ClassTable is frozen once the constructor is done, so classes can be
+// checked concurrently as long as each thread has its own CheckState.
+struct CheckState {
+  Class_ current_class;
+  TypeId current_class_id;
+  const AttrEnv *current_env;
+
+  // Bitsets over type IDs for spotting duplicate case branches, one per
+  // level of case nesting so an inner case can't clobber the marks of
+  // the case it sits in. Each is cleared again by its user.
+  std::deque<std::vector<bool> > case_branches;
+  size_t case_depth;
+
+  ScopedTable<Symbol, Entry> symbols;
+  int errors;
+  ostream *out;
+
+  // When set, every type name the check looks up is added here.
+  DepSet *deps;
+
+  SemantStats stats;
+
+  CheckState(ostream *o) : current_class(NULL), current_class_id(INVALID_TYPE_ID),
+    current_env(NULL), case_depth(0), errors(0), out(o), deps(NULL) { }
+};
+
+// One class handed to a checking thread, and what checking it produced.
+struct ClassCheck {
+  Class_ c;
+  std::ostringstream out;
+  int errors;
+  bool track_deps;
+  DepSet deps;
+  SemantStats stats;
+
+  ClassCheck() : c(NULL), errors(0), track_deps(false) { }
+};
+
+// What checking a class produced, as written to the type-check cache.
+// deps are the class names the check looked up, with the effective
+// signature hash each had at the time (0 if it was not a class); types
+// are the expression types in walk order.
+struct ClassRecord {
+  uint64_t body_hash;
+  bool had_errors;
+  std::vector<Symbol> deps;
+  std::vector<uint64_t> dep_signatures;
+  std::vector<Symbol> types;
+
+  ClassRecord() : body_hash(0), had_errors(false) { }
+};
+
+// On-disk layout of the type-check cache. The file is mapped and used
+// in place: a header, the records sorted by body hash, the per-record
+// arrays, and a string section that all names refer to by index.
+struct CacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t nstrings;
+  uint32_t nrecords;
+  uint32_t reserved;
+  uint64_t strings;       // offset of nstrings uint32 offsets into the file
+  uint64_t records;       // offset of nrecords CacheRecords
+};
+
+struct CacheRecord {
+  uint64_t body_hash;
+  uint32_t had_errors;
+  uint32_t ndeps;
+  uint32_t ntypes;
+  uint32_t reserved;
+  uint64_t data;          // ndeps uint64 signatures, ndeps uint32 names, ntypes uint32 types
+};
+
+// The memory-mapped type-check cache named by COOL_SEMANT_STATE, keyed
+// by the hash of each class's tree.
+class SemantCache {
+private:
+  char *base;
+  size_t size;
+  const CacheHeader *header;
+  std::vector<Symbol> symbols;     // interned lazily, by string index
+
+  bool in_bounds(uint64_t offset, uint64_t bytes) const { return offset <= size && bytes <= size - offset; }
+
+public:
+  SemantCache() : base(NULL), size(0), header(NULL) { }
+  ~SemantCache() { close(); }
+
+  bool open(const char *path);
+  void close();
+
+  bool find(uint64_t body_hash, ClassRecord& record);
+  static bool write(const char *path, const std::vector<ClassRecord>& records);
+};
+
 // This is a structure that may be used to contain the semantic
 // information such as the inheritance graph.  You may use it or not as
 // you like: it is only here to provide a container for the supplied
@@ -21,35 +202,96 @@ typedef ClassTable *ClassTableP;
 
 class ClassTable {
 private:
-  int semant_errors;
   void install_basic_classes();
+  void install_interface_classes();
+  bool read_interface(const char *path);
   ostream& error_stream;
   Classes classes_;
-  Class_ current_class_;
+  Classes interfaces_;
+
+  // State of the constructor and of a sequential check. Worker threads
+  // point local_state_ at their own CheckState instead.
+  CheckState main_state_;
+  static thread_local CheckState *local_state_;
+  CheckState& state() { return local_state_ != NULL ? *local_state_ : main_state_; }
+
+  TypeIds type_ids_;
+  std::vector<Symbol> type_names_;
+  std::vector<Class_> classes_by_id_;
+  std::vector<ClassNode> class_nodes_;
+  std::vector<MethodTable> method_tables_;
+  std::vector<AttrEnv> attr_envs_;
+
+  // Per-phase and per-class figures for the COOL_SEMANT_STATS report.
+  // The query counters are only kept when the report is asked for.
+  const bool stats_enabled_;
+  std::chrono::steady_clock::time_point phase_clock_;
+  std::vector<std::pair<const char *, SemantStats> > phase_stats_;
+  std::vector<std::pair<Symbol, SemantStats> > class_stats_;
+
+  void number_classes();
+  void build_method_table(TypeId t);
+  void build_attr_env(TypeId t);
+
+  bool is_class_id(TypeId t) { return t >= FIRST_CLASS_ID && t < classes_by_id_.size(); }
+  TypeId resolve(TypeId t) { return (t == SELF_TYPE_ID) ? state().current_class_id : t; }
+  bool below(TypeId t1, TypeId t2);
+  void count(unsigned long SemantStats::*counter, unsigned long n = 1)
+  {
+    if (stats_enabled_)
+      state().stats.*counter += n;
+  }
+
+  void enter_globals(ScopedTable<Symbol, Entry>& symbols, const std::vector<Class_>& all);
+  void check_worker(std::vector<ClassCheck>& jobs, const std::vector<Class_>& all, 
+                    std::atomic<int>& next);
+
+  std::vector<uint64_t> signature_hashes();
+  bool replay(Class_ c, uint64_t body_hash, SemantCache& cache, 
+              const std::vector<uint64_t>& signatures, ClassRecord& record);
 
 public:
   ClassTable(Classes);
-  int errors() { return semant_errors; }
+  int errors() { return main_state_.errors; }
   ostream& semant_error();
   ostream& semant_error(Class_ c);
   ostream& semant_error(Symbol filename, tree_node *t);
 
+  TypeId get_type_id(Symbol name);
+  Symbol get_type_name(TypeId t) { return type_names_[t]; }
+
   Class_ get_class(Symbol name);
-  bool check_class(Class_ c);
+  void check_inheritance(Classes classes);
 
-  void set_current_class(Class_ c) { current_class_ = c; }
-  Class_ get_current_class() { return current_class_; }
+  void set_current_class(Class_ c);
+  Class_ get_current_class() { return state().current_class; }
+
+  void check_classes(Classes classes);
+  bool write_interface(const char *path, Classes classes);
+
+  void begin_phase();
+  void end_phase(const char *name);
+  void print_stats(ostream& out);
 
   Symbol get_return_type(Symbol c, Symbol m);
   method_class* get_method(Class_ c, Symbol m);
+  method_class* get_method(TypeId t, Symbol m);
 
   void publish_variables(Class_ c);
+  const AttrEnv* get_attr_env() { return state().current_env; }
+  Symbol lookup_variable(Symbol name);
   void publish_variables(method_class* m); 
 
   bool is_subclass(Class_ c1, Class_ c2);
-  Symbol get_lub(Class_ c1, Class_ c2);
+  bool conforms(Symbol t1, Symbol t2);
+  bool conforms(TypeId t1, TypeId t2);
+  Symbol lub(Symbol t1, Symbol t2);
+  TypeId lub(TypeId t1, TypeId t2);
+
+  std::vector<bool>& enter_case();
+  void exit_case() { state().case_depth--; }
 
-  SymbolTable<Symbol, Entry> symbols_;
+  ScopedTable<Symbol, Entry>& symbols() { return state().symbols; }
 };
 
 
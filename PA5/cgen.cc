@@ -24,10 +24,19 @@
 
 #include "cgen.h"
 #include "cgen_gc.h"
+#include "../PA2/interntab.h"
 
 extern void emit_string_constant(ostream& str, char *s);
 extern int cgen_debug;
 
+//
+// Hash indexes over the global tables. Looking a name up in a table
+// directly walks its whole list.
+//
+static InternIndex<IdEntry> id_index(idtable);
+static InternIndex<StringEntry> string_index(stringtable);
+static InternIndex<IntEntry> int_index(inttable);
+
 //
 // Three symbols from the semantic analyzer (semant.cc) are used.
 // If e : No_type, then no code is generated for e.
@@ -512,10 +521,10 @@ void BoolConst::code_def(ostream& s, int boolclasstag)
 
 void CgenClassTable::code_global_data()
 {
-  Symbol main    = idtable.lookup_string(MAINNAME);
-  Symbol string  = idtable.lookup_string(STRINGNAME);
-  Symbol integer = idtable.lookup_string(INTNAME);
-  Symbol boolc   = idtable.lookup_string(BOOLNAME);
+  Symbol main    = id_index.lookup_string(MAINNAME);
+  Symbol string  = id_index.lookup_string(STRINGNAME);
+  Symbol integer = id_index.lookup_string(INTNAME);
+  Symbol boolc   = id_index.lookup_string(BOOLNAME);
 
   str << "\t.data\n" << ALIGN;
   //
@@ -836,11 +845,11 @@ void CgenNode::code_prototype(ostream& s)
 
         if (a->get_type() == Str)        
         {
-            s << WORD; stringtable.lookup_string("")->code_ref(s); s << endl;
+            s << WORD; string_index.lookup_string("")->code_ref(s); s << endl;
         }
         else if (a->get_type() == Int)
         {
-            s << WORD; inttable.lookup_string("0")->code_ref(s); s << endl;
+            s << WORD; int_index.lookup_string("0")->code_ref(s); s << endl;
         }
         else if (a->get_type() == Bool)
         {
@@ -865,7 +874,7 @@ void prototype_objects(CgenNode* n, ostream& s)
 
 void CgenNode::code_class_name_tab(ostream& s)
 {
-    s << WORD; stringtable.lookup_string(name->get_string())->code_ref(s); s << endl;
+    s << WORD; string_index.lookup_string(name->get_string())->code_ref(s); s << endl;
 }
 
 void class_name_tab_(CgenNode* n, ostream& s)
@@ -996,7 +1005,7 @@ CgenNode::CgenNode(Class_ nd, Basicness bstatus, CgenClassTableP ct) :
 { 
    static int id_counter = 0;
    id = id_counter++;
-   stringtable.add_string(name->get_string());          // Add class name to string table
+   string_index.add_string(name->get_string());          // Add class name to string table
 }
 
 
@@ -1066,12 +1075,12 @@ void int_const_class::code(ostream& s)
   //
   // Need to be sure we have an IntEntry *, not an arbitrary Symbol
   //
-  emit_load_int(ACC,inttable.lookup_string(token->get_string()),s);
+  emit_load_int(ACC,int_index.lookup_string(token->get_string()),s);
 }
 
 void string_const_class::code(ostream& s)
 {
-  emit_load_string(ACC,stringtable.lookup_string(token->get_string()),s);
+  emit_load_string(ACC,string_index.lookup_string(token->get_string()),s);
 }
 
 void bool_const_class::code(ostream& s)
@@ -3,7 +3,7 @@
 #include <sstream>
 #include "emit.h"
 #include "cool-tree.h"
-#include "symtab.h"
+#include "../PA4/scopedtab.h"
 
 using std::stringstream;
 using std::string;
@@ -18,7 +18,7 @@ typedef CgenClassTable *CgenClassTableP;
 class CgenNode;
 typedef CgenNode *CgenNodeP;
 
-class CgenClassTable : public SymbolTable<Symbol,CgenNode> {
+class CgenClassTable : public ScopedTable<Symbol,CgenNode> {
 private:
    List<CgenNode> *nds;
    ostream& str;